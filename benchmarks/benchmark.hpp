@@ -0,0 +1,45 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_BENCHMARK_HPP
+#define VCE_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+
+/// Prevents the compiler from optimizing away the computation of the supplied value.
+template <class T>
+void keep(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/// Runs the supplied function the supplied number of times and prints the average time taken.
+template <class F>
+void measure(const char* name, size_t iterations, F f) {
+    for (size_t i = 0; i < iterations / 10 + 1; ++i) {
+        f();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto total = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-48s %12.2f ns\n", name, total / iterations);
+}
+
+#endif
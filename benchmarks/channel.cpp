@@ -0,0 +1,131 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "benchmark.hpp"
+
+#include <vivace/channel.hpp>
+
+using namespace vce;
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+static constexpr int64_t ITEMS = 1 << 20;
+static constexpr size_t CAPACITY = 1024;
+
+/// A bounded queue guarded by a mutex.
+class LockedQueue {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::queue<int64_t> items;
+    size_t producers;
+
+public:
+    explicit LockedQueue(size_t producers) : producers{producers} { }
+
+    void push(int64_t item) {
+        std::unique_lock<std::mutex> lock{mutex};
+        changed.wait(lock, [&] { return items.size() < CAPACITY; });
+        items.push(item);
+        changed.notify_all();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock{mutex};
+        producers -= 1;
+        changed.notify_all();
+    }
+
+    bool pop(int64_t& item) {
+        std::unique_lock<std::mutex> lock{mutex};
+        changed.wait(lock, [&] { return !items.empty() || producers == 0; });
+        if (items.empty()) {
+            return false;
+        }
+        item = items.front();
+        items.pop();
+        changed.notify_all();
+        return true;
+    }
+};
+
+/// Runs the supplied producers and consumers and returns the total of the items consumed.
+template <class P, class C>
+int64_t run(size_t producers, size_t consumers, P produce, C consume) {
+    std::vector<std::thread> threads;
+    std::vector<int64_t> totals(consumers);
+    for (size_t i = 0; i < producers; ++i) {
+        threads.emplace_back([&, i] { produce(i); });
+    }
+    for (size_t i = 0; i < consumers; ++i) {
+        threads.emplace_back([&, i] { totals[i] = consume(i); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return range<size_t>(0, consumers).map([&](size_t i) { return totals[i]; }).sum();
+}
+
+int main() {
+    for (size_t producers : {1, 4}) {
+        auto per = ITEMS / static_cast<int64_t>(producers);
+        auto name = [&](const char* method) {
+            static std::string buffer;
+            buffer = std::to_string(producers) + " producers (" + method + ")";
+            return buffer.c_str();
+        };
+
+        measure(name("std::queue + std::mutex"), 5, [&] {
+            LockedQueue queue{producers};
+            keep(run(producers, 1, [&](size_t i) {
+                for (auto item = i * per; item < (i + 1) * per; ++item) {
+                    queue.push(static_cast<int64_t>(item));
+                }
+                queue.close();
+            }, [&](size_t) {
+                int64_t total = 0;
+                int64_t item;
+                while (queue.pop(item)) {
+                    total += item;
+                }
+                return total;
+            }));
+        });
+
+        if (producers == 1) {
+            measure(name("vce::spsc_channel"), 5, [&] {
+                auto [sender, receiver] = spsc_channel<int64_t>(CAPACITY);
+                keep(run(1, 1, [&, sender = std::move(sender)](size_t) mutable {
+                    sender.send_all(range<int64_t>(0, per));
+                    auto closed = std::move(sender);
+                }, [&](size_t) { return receiver.sum(); }));
+            });
+        }
+
+        measure(name("vce::mpmc_channel"), 5, [&] {
+            auto [sender, receiver] = mpmc_channel<int64_t>(CAPACITY);
+            std::vector<MpmcSender<int64_t>> senders(producers, sender);
+            { auto closed = std::move(sender); }
+            keep(run(producers, 1, [&](size_t i) {
+                auto own = std::move(senders[i]);
+                auto begin = static_cast<int64_t>(i) * per;
+                own.send_all(range<int64_t>(begin, begin + per));
+            }, [&](size_t) { return receiver.sum(); }));
+        });
+    }
+}
@@ -0,0 +1,97 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "benchmark.hpp"
+
+#include <vivace/format.hpp>
+
+using namespace vce;
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static constexpr size_t SIZE = 1 << 12;
+
+int main() {
+    std::mt19937 random{322};
+    std::vector<Option<int>> options;
+    std::vector<Result<double, int>> results;
+    std::vector<Bounds> bounds;
+    for (size_t i = 0; i < SIZE; ++i) {
+        auto value = static_cast<int>(random());
+        options.push_back(value % 4 == 0 ? Option<int>{} : Option<int>{value});
+        if (value % 4 == 0) {
+            results.push_back({ERR, value});
+        } else {
+            results.push_back({OK, value / 1000.0});
+        }
+        bounds.push_back(Bounds{i, i * 2});
+    }
+
+    measure("Option<int> (std::ostringstream)", 100, [&] {
+        std::ostringstream stream;
+        for (const auto& option : options) {
+            stream << option << "\n";
+        }
+        keep(stream.str().size());
+    });
+
+    measure("Option<int> (vce::format_to)", 100, [&] {
+        std::string buffer;
+        for (const auto& option : options) {
+            format_to(buffer, option);
+            buffer += '\n';
+        }
+        keep(buffer.size());
+    });
+
+    measure("Result<double, int> (std::ostringstream)", 100, [&] {
+        std::ostringstream stream;
+        for (const auto& result : results) {
+            stream << result << "\n";
+        }
+        keep(stream.str().size());
+    });
+
+    measure("Result<double, int> (vce::format_to)", 100, [&] {
+        std::string buffer;
+        for (const auto& result : results) {
+            format_to(buffer, result);
+            buffer += '\n';
+        }
+        keep(buffer.size());
+    });
+
+    measure("Bounds (std::ostringstream)", 100, [&] {
+        std::ostringstream stream;
+        for (auto bound : bounds) {
+            stream << bound << "\n";
+        }
+        keep(stream.str().size());
+    });
+
+    measure("Bounds (vce::format_to)", 100, [&] {
+        char buffer[FORMAT_SIZE<Bounds> + 1];
+        size_t total = 0;
+        for (auto bound : bounds) {
+            auto end = format_to(buffer, bound);
+            *end++ = '\n';
+            total += static_cast<size_t>(end - buffer);
+        }
+        keep(total);
+    });
+}
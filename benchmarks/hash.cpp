@@ -0,0 +1,109 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "benchmark.hpp"
+
+#include <vivace/flat_hash.hpp>
+#include <vivace/hash.hpp>
+
+using namespace vce;
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static constexpr size_t SIZE = 1 << 16;
+
+/// Returns the total number of probes needed to insert the supplied keys into a linear probing
+/// table with twice as many slots as keys.
+template <class H, class T>
+size_t probes(const std::vector<T>& keys, H hash) {
+    auto mask = 2 * keys.size() - 1;
+    std::vector<bool> occupied(mask + 1);
+    size_t total = 0;
+    for (const auto& key : keys) {
+        auto slot = hash(key) & mask;
+        while (occupied[slot]) {
+            slot = (slot + 1) & mask;
+            total += 1;
+        }
+        occupied[slot] = true;
+    }
+    return total;
+}
+
+template <class T>
+void compare(const char* name, const std::vector<T>& keys) {
+    std::printf("%s\n", name);
+    std::printf("  %-46s %12zu\n", "probes (std::hash)", probes(keys, std::hash<T>{}));
+    std::printf("  %-46s %12zu\n", "probes (vce::Hash)", probes(keys, Hash{}));
+
+    measure("  std::hash", 1000, [&] {
+        size_t total = 0;
+        for (const auto& key : keys) {
+            total += std::hash<T>{}(key);
+        }
+        keep(total);
+    });
+
+    measure("  vce::Hash", 1000, [&] {
+        size_t total = 0;
+        for (const auto& key : keys) {
+            total += Hash{}(key);
+        }
+        keep(total);
+    });
+}
+
+/// Measures building a map from the supplied keys and then looking up every key.
+template <class M, class T>
+void lookup(const char* name, const std::vector<T>& keys) {
+    measure(name, 100, [&] {
+        M map;
+        map.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            map[keys[i]] = i;
+        }
+        size_t total = 0;
+        for (const auto& key : keys) {
+            total += map.find(key)->second;
+        }
+        keep(total);
+    });
+}
+
+template <class T>
+void maps(const char* name, const std::vector<T>& keys) {
+    std::printf("%s\n", name);
+    lookup<std::unordered_map<T, size_t, Hash>>("  std::unordered_map", keys);
+    lookup<FlatHashMap<T, size_t>>("  vce::FlatHashMap", keys);
+}
+
+int main() {
+    std::vector<uint64_t> strided(SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        strided[i] = i << 16;
+    }
+    compare("uint64_t (strided)", strided);
+
+    std::vector<std::string> strings(SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        strings[i] = "key-" + std::to_string(i);
+    }
+    compare("std::string", strings);
+
+    maps("uint64_t (strided) lookups", strided);
+    maps("std::string lookups", strings);
+}
@@ -0,0 +1,117 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "benchmark.hpp"
+
+#include <vivace/divider.hpp>
+#include <vivace/math.hpp>
+
+using namespace vce;
+
+#include <vector>
+
+static constexpr size_t SIZE = 1 << 16;
+
+template <class T>
+void add(const char* name) {
+    std::vector<T> left(SIZE, 3);
+    std::vector<T> right(SIZE, 4);
+    std::vector<T> out(SIZE);
+
+    std::printf("%s\n", name);
+
+    measure("  checked_add (scalar)", 1000, [&] {
+        for (size_t i = 0; i < SIZE; ++i) {
+            auto sum = checked_add(left[i], right[i]);
+            if (sum.is_none()) {
+                break;
+            }
+            out[i] = sum.unwrap();
+        }
+        keep(out);
+    });
+
+    measure("  checked_add (span)", 1000, [&] {
+        keep(checked_add<T>(left, right, out));
+    });
+
+    measure("  checked_sum", 1000, [&] {
+        keep(checked_sum<T>(left));
+    });
+
+    measure("  saturating_add (scalar)", 1000, [&] {
+        for (size_t i = 0; i < SIZE; ++i) {
+            out[i] = saturating_add(left[i], right[i]);
+        }
+        keep(out);
+    });
+
+    measure("  saturating_add (span)", 1000, [&] {
+        saturating_add<T>(left, right, out);
+        keep(out);
+    });
+}
+
+template <class T>
+void divide(const char* name) {
+    std::vector<T> values(SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        values[i] = static_cast<T>(i * 2654435761u);
+    }
+    std::vector<T> out(SIZE);
+
+    T divisor = 7;
+    keep(divisor);
+    auto d = divider(divisor).unwrap();
+
+    std::printf("%s\n", name);
+
+    measure("  checked_div", 1000, [&] {
+        for (size_t i = 0; i < SIZE; ++i) {
+            out[i] = checked_div(values[i], divisor).unwrap();
+        }
+        keep(out);
+    });
+
+    measure("  Divider::div (scalar)", 1000, [&] {
+        for (size_t i = 0; i < SIZE; ++i) {
+            out[i] = d.div(values[i]);
+        }
+        keep(out);
+    });
+
+    measure("  Divider::div (span)", 1000, [&] {
+        d.div(values, out);
+        keep(out);
+    });
+
+    measure("  Divider::rem (span)", 1000, [&] {
+        d.rem(values, out);
+        keep(out);
+    });
+}
+
+int main() {
+    add<int8_t>("int8_t");
+    add<uint16_t>("uint16_t");
+    add<int32_t>("int32_t");
+    add<int64_t>("int64_t");
+    add<uint64_t>("uint64_t");
+
+    divide<uint16_t>("uint16_t");
+    divide<int32_t>("int32_t");
+    divide<uint32_t>("uint32_t");
+    divide<uint64_t>("uint64_t");
+}
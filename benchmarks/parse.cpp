@@ -0,0 +1,87 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "benchmark.hpp"
+
+#include <vivace/parse.hpp>
+#include <vivace/string.hpp>
+
+using namespace vce;
+
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static constexpr size_t SIZE = 1 << 14;
+
+int main() {
+    std::mt19937_64 random{322};
+    for (size_t digits : {4, 8, 16}) {
+        std::uniform_int_distribution<int64_t> distribution{0, 9};
+        std::string text;
+        for (size_t i = 0; i < SIZE; ++i) {
+            for (size_t j = 0; j < digits; ++j) {
+                text += static_cast<char>('0' + distribution(random));
+            }
+            text += ' ';
+        }
+        auto fields = split_whitespace(text).collect();
+
+        auto name = [&](const char* method) {
+            static std::string buffer;
+            buffer = std::to_string(digits) + " digits (" + method + ")";
+            return buffer.c_str();
+        };
+
+        measure(name("std::stoll"), 100, [&] {
+            int64_t total = 0;
+            for (auto field : fields) {
+                total += std::stoll(std::string{field});
+            }
+            keep(total);
+        });
+
+        measure(name("std::istringstream"), 100, [&] {
+            std::istringstream stream{text};
+            int64_t total = 0;
+            int64_t value;
+            while (stream >> value) {
+                total += value;
+            }
+            keep(total);
+        });
+
+        measure(name("std::strtoll"), 100, [&] {
+            int64_t total = 0;
+            auto cursor = text.c_str();
+            for (size_t i = 0; i < SIZE; ++i) {
+                char* end;
+                total += std::strtoll(cursor, &end, 10);
+                cursor = end;
+            }
+            keep(total);
+        });
+
+        measure(name("vce::parse"), 100, [&] {
+            int64_t total = 0;
+            for (auto field : fields) {
+                total += parse<int64_t>(field).unwrap();
+            }
+            keep(total);
+        });
+    }
+}
@@ -0,0 +1,115 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "benchmark.hpp"
+
+#include <vivace/result.hpp>
+
+using namespace vce;
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static constexpr size_t SIZE = 1 << 16;
+
+struct Error {
+    int code;
+};
+
+__attribute__((noinline)) Result<int, Error> step(int value, bool fail) {
+    if (fail) {
+        return {ERR, Error{value}};
+    } else {
+        return {OK, value + 1};
+    }
+}
+
+__attribute__((noinline)) Result<int, Error> propagate(int value, bool fail) {
+    auto a = VCE_TRY(step(value, false));
+    auto b = VCE_TRY(step(a, fail));
+    auto c = VCE_TRY(step(b, false));
+    return {OK, c};
+}
+
+__attribute__((noinline)) Result<int, Error> check(int value, bool fail) {
+    auto a = step(value, false);
+    if (a.is_err()) {
+        return {ERR, a.unwrap_err()};
+    }
+    auto b = step(a.unwrap(), fail);
+    if (b.is_err()) {
+        return {ERR, b.unwrap_err()};
+    }
+    auto c = step(b.unwrap(), false);
+    if (c.is_err()) {
+        return {ERR, c.unwrap_err()};
+    }
+    return {OK, c.unwrap()};
+}
+
+__attribute__((noinline)) int step_throw(int value, bool fail) {
+    if (fail) {
+        throw std::runtime_error{"failure"};
+    } else {
+        return value + 1;
+    }
+}
+
+__attribute__((noinline)) int propagate_throw(int value, bool fail) {
+    auto a = step_throw(value, false);
+    auto b = step_throw(a, fail);
+    return step_throw(b, false);
+}
+
+int main() {
+    std::mt19937 random{322};
+    for (double rate : {0.0, 0.001, 0.01, 0.1, 0.5}) {
+        std::bernoulli_distribution distribution{rate};
+        std::vector<bool> failures(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            failures[i] = distribution(random);
+        }
+
+        std::printf("error rate: %g\n", rate);
+
+        measure("  VCE_TRY", 100, [&] {
+            int sum = 0;
+            for (size_t i = 0; i < SIZE; ++i) {
+                sum += propagate(i, failures[i]).unwrap_or(0);
+            }
+            keep(sum);
+        });
+
+        measure("  is_err/unwrap", 100, [&] {
+            int sum = 0;
+            for (size_t i = 0; i < SIZE; ++i) {
+                sum += check(i, failures[i]).unwrap_or(0);
+            }
+            keep(sum);
+        });
+
+        measure("  exceptions", 100, [&] {
+            int sum = 0;
+            for (size_t i = 0; i < SIZE; ++i) {
+                try {
+                    sum += propagate_throw(i, failures[i]);
+                } catch (const std::runtime_error&) { }
+            }
+            keep(sum);
+        });
+    }
+}
@@ -0,0 +1,79 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark.hpp"
+
+#include <vivace/csv.hpp>
+#include <vivace/string.hpp>
+
+using namespace vce;
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+static constexpr size_t LINES = 1 << 14;
+
+int main() {
+    std::string text;
+    for (size_t i = 0; i < LINES; ++i) {
+        text += "2017-06-01 12:00:00 GET /index.html 200 " + std::to_string(i) + "\n";
+    }
+
+    measure("lines (std::getline)", 100, [&] {
+        std::istringstream stream{text};
+        std::string line;
+        size_t total = 0;
+        while (std::getline(stream, line)) {
+            total += line.size();
+        }
+        keep(total);
+    });
+
+    measure("lines (vce::lines)", 100, [&] {
+        keep(lines(text).map([](auto l) { return l.size(); }).sum());
+    });
+
+    measure("fields (std::istringstream)", 100, [&] {
+        std::istringstream stream{text};
+        std::string field;
+        size_t total = 0;
+        while (stream >> field) {
+            total += field.size();
+        }
+        keep(total);
+    });
+
+    measure("fields (vce::split_whitespace)", 100, [&] {
+        keep(split_whitespace(text).map([](auto f) { return f.size(); }).sum());
+    });
+
+    measure("fields (vce::split)", 100, [&] {
+        keep(split(text, ' ').map([](auto f) { return f.size(); }).sum());
+    });
+
+    std::string csv;
+    for (size_t i = 0; i < LINES; ++i) {
+        csv += std::to_string(i) + ",2017-06-01 12:00:00,\"GET /index.html\",200,";
+        csv += "\"Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko)\",0.25\n";
+    }
+
+    measure("csv (vce::csv_rows)", 100, [&] {
+        size_t total = 0;
+        for (auto row : csv_rows(csv)) {
+            total += row.unwrap().size();
+        }
+        keep(total);
+    });
+}
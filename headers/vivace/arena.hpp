@@ -0,0 +1,181 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_ARENA_HPP
+#define VCE_ARENA_HPP
+
+#include <vivace/utility.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace vce {
+
+/// A region of memory which values are allocated from by bumping a pointer.
+///
+/// Memory is never returned to the arena one allocation at a time. Instead the arena is reset or
+/// rewound to an earlier mark which releases every allocation made since in constant time. The
+/// chunks of memory backing the arena are kept for reuse until the arena is destroyed.
+class Arena {
+    struct Chunk;
+
+    Chunk* first = nullptr;
+    Chunk* current = nullptr;
+    char* pointer = nullptr;
+    char* end = nullptr;
+    size_t next_size;
+    size_t capacity_ = 0;
+
+    void* allocate_slow(size_t size, size_t alignment);
+    void enter(Chunk* chunk);
+public:
+    /// A position in an arena which the arena can be rewound to.
+    class Mark {
+        friend class Arena;
+
+        Chunk* chunk;
+        char* pointer;
+
+        Mark(Chunk* chunk, char* pointer) : chunk{chunk}, pointer{pointer} { }
+    };
+
+    /// Rewinds an arena to the position it was at when this scope was constructed when this scope
+    /// is destroyed.
+    class Scope {
+        Arena& arena;
+        Mark mark;
+    public:
+        /// Constructs a scope for the supplied arena.
+        explicit Scope(Arena& arena) : arena{arena}, mark{arena.mark()} { }
+
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+
+        ~Scope() {
+            arena.rewind(mark);
+        }
+    };
+
+    /// Constructs an arena whose first chunk of memory will contain the supplied number of bytes.
+    explicit Arena(size_t size = 4096) : next_size{size} { }
+
+    Arena(const Arena& other) = delete;
+    Arena& operator=(const Arena& other) = delete;
+
+    ~Arena();
+
+    /// Returns the number of bytes in the chunks of memory backing this arena.
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    /// Returns uninitialized memory with the supplied size and alignment.
+    void* allocate(size_t size, size_t alignment) {
+        auto address = reinterpret_cast<uintptr_t>(pointer);
+        auto aligned = reinterpret_cast<char*>((address + alignment - 1) & ~(alignment - 1));
+        if (VCE_LIKELY(pointer != nullptr && aligned <= end &&
+                       size <= static_cast<size_t>(end - aligned))) {
+            pointer = aligned + size;
+            return aligned;
+        } else {
+            return allocate_slow(size, alignment);
+        }
+    }
+
+    /// Returns uninitialized memory for the supplied number of values.
+    template <class T>
+    T* allocate(size_t count) {
+        if (VCE_UNLIKELY(count > Limits<size_t>::max() / sizeof(T))) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /// Returns the current position of this arena.
+    Mark mark() const {
+        return {current, pointer};
+    }
+
+    /// Releases every allocation made since the supplied position of this arena was returned.
+    void rewind(Mark mark) {
+        if (mark.chunk != nullptr) {
+            enter(mark.chunk);
+            pointer = mark.pointer;
+        } else {
+            reset();
+        }
+    }
+
+    /// Releases every allocation made from this arena.
+    void reset() {
+        if (first != nullptr) {
+            enter(first);
+        }
+    }
+
+    /// Returns a scope which rewinds this arena to its current position when it is destroyed.
+    Scope scope() {
+        return Scope{*this};
+    }
+};
+
+/// An allocator which allocates memory from an arena.
+///
+/// Deallocation does nothing since the memory is released when the arena is reset or rewound.
+template <class T>
+class ArenaAllocator {
+    template <class U>
+    friend class ArenaAllocator;
+
+    template <class L, class R>
+    friend bool operator==(const ArenaAllocator<L>& left, const ArenaAllocator<R>& right);
+
+    Arena* arena;
+public:
+    using value_type = T;
+
+    /// Constructs an allocator which allocates memory from the supplied arena.
+    ArenaAllocator(Arena& arena) : arena{&arena} { }
+
+    /// Constructs an allocator which allocates memory from the same arena as the supplied
+    /// allocator.
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena{other.arena} { }
+
+    /// Returns uninitialized memory for the supplied number of values.
+    T* allocate(size_t count) {
+        return arena->allocate<T>(count);
+    }
+
+    /// Does nothing.
+    void deallocate(T*, size_t) { }
+};
+
+/// Returns whether the supplied allocators allocate memory from the same arena, which is whether
+/// memory allocated by one can be deallocated by the other.
+template <class L, class R>
+bool operator==(const ArenaAllocator<L>& left, const ArenaAllocator<R>& right) {
+    return left.arena == right.arena;
+}
+
+template <class L, class R>
+bool operator!=(const ArenaAllocator<L>& left, const ArenaAllocator<R>& right) {
+    return !(left == right);
+}
+
+}
+
+#endif
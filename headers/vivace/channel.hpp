@@ -0,0 +1,481 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_CHANNEL_HPP
+#define VCE_CHANNEL_HPP
+
+#include <vivace/iterator.hpp>
+#include <vivace/result.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace vce {
+
+namespace detail {
+    /// The number of bytes the indices of queues are separated by to avoid false sharing.
+    constexpr size_t CACHE_LINE = 64;
+
+    /// Returns the supplied capacity of a queue rounded up to a power of two.
+    ///
+    /// Panics if the capacity is zero.
+    inline size_t queue_capacity(size_t capacity) {
+        if (capacity == 0) {
+            detail::panic("attempted to create a channel without capacity");
+        }
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    /// Hints to the processor that the calling thread is spinning.
+    inline void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    /// Blocks threads until a condition is satisfied after spinning for a while.
+    class Parker {
+        /// The number of times the condition is checked before a thread is blocked.
+        static constexpr size_t SPINS = 256;
+
+        std::atomic<size_t> waiters{0};
+        std::mutex mutex;
+        std::condition_variable condition;
+
+    public:
+        /// Blocks until the supplied function returns `true`.
+        ///
+        /// The function is called again whenever this parker is notified.
+        template <class F>
+        void wait(F ready) {
+            for (size_t i = 0; i < SPINS; ++i) {
+                if (ready()) {
+                    return;
+                } else if (i < SPINS / 2) {
+                    relax();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+
+            std::unique_lock<std::mutex> lock{mutex};
+            waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!ready()) {
+                condition.wait(lock);
+            }
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /// Wakes the threads blocked by this parker after the condition may have changed.
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) != 0) {
+                std::lock_guard<std::mutex> lock{mutex};
+                condition.notify_all();
+            }
+        }
+    };
+
+    /// A bounded single-producer single-consumer ring buffer.
+    ///
+    /// Each side keeps a copy of the index of the other side which is only refreshed when the
+    /// buffer appears full or empty. Pushed values are only visible to the consumer once they are
+    /// published so that a batch of values is published with a single store.
+    template <class T>
+    class SpscQueue {
+        using Slot = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+        size_t mask;
+        std::unique_ptr<Slot[]> slots;
+
+        alignas(CACHE_LINE) std::atomic<size_t> head{0};
+        size_t cached_tail{0};
+
+        alignas(CACHE_LINE) std::atomic<size_t> tail{0};
+        size_t pending{0};
+        size_t cached_head{0};
+
+        T& get(size_t index) {
+            return reinterpret_cast<T&>(slots[index & mask]);
+        }
+
+    public:
+        /// Whether multiple threads may push and pop values.
+        static constexpr bool MULTIPLE = false;
+
+        explicit SpscQueue(size_t capacity)
+            : mask{queue_capacity(capacity) - 1}, slots{new Slot[mask + 1]} { }
+
+        SpscQueue(const SpscQueue& other) = delete;
+        SpscQueue& operator=(const SpscQueue& other) = delete;
+
+        ~SpscQueue() {
+            for (auto index = head.load(); index != pending; ++index) {
+                get(index).~T();
+            }
+        }
+
+        /// Moves the supplied value into this queue unless it is full, which only the producer may
+        /// do.
+        bool push(T& value) {
+            if (pending - cached_head > mask) {
+                cached_head = head.load(std::memory_order_acquire);
+                if (pending - cached_head > mask) {
+                    return false;
+                }
+            }
+            new (&get(pending)) T(std::move(value));
+            pending += 1;
+            return true;
+        }
+
+        /// Makes the pushed values visible to the consumer, which only the producer may do.
+        void publish() {
+            tail.store(pending, std::memory_order_release);
+        }
+
+        /// Removes the oldest published value from this queue, which only the consumer may do.
+        Option<T> pop() {
+            auto index = head.load(std::memory_order_relaxed);
+            if (index == cached_tail) {
+                cached_tail = tail.load(std::memory_order_acquire);
+                if (index == cached_tail) {
+                    return {};
+                }
+            }
+            auto& slot = get(index);
+            Option<T> value{std::move(slot)};
+            slot.~T();
+            head.store(index + 1, std::memory_order_release);
+            return value;
+        }
+    };
+
+    /// A bounded multiple-producer multiple-consumer queue.
+    ///
+    /// Each cell has a sequence number which indicates whether it is ready to be written or read
+    /// in the current lap around the buffer so producers and consumers only contend on the index
+    /// of their side and the cell they claim.
+    template <class T>
+    class MpmcQueue {
+        struct Cell {
+            std::atomic<size_t> sequence;
+            std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+        };
+
+        size_t mask;
+        std::unique_ptr<Cell[]> cells;
+
+        alignas(CACHE_LINE) std::atomic<size_t> enqueue{0};
+        alignas(CACHE_LINE) std::atomic<size_t> dequeue{0};
+
+    public:
+        /// Whether multiple threads may push and pop values.
+        static constexpr bool MULTIPLE = true;
+
+        explicit MpmcQueue(size_t capacity)
+            : mask{std::max<size_t>(queue_capacity(capacity), 2) - 1}, cells{new Cell[mask + 1]} {
+            for (size_t i = 0; i <= mask; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpmcQueue(const MpmcQueue& other) = delete;
+        MpmcQueue& operator=(const MpmcQueue& other) = delete;
+
+        ~MpmcQueue() {
+            while (pop().is_some()) { }
+        }
+
+        /// Moves the supplied value into this queue unless it is full.
+        bool push(T& value) {
+            auto position = enqueue.load(std::memory_order_relaxed);
+            while (true) {
+                auto& cell = cells[position & mask];
+                auto sequence = cell.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<intptr_t>(sequence - position);
+                if (difference == 0) {
+                    if (enqueue.compare_exchange_weak(position, position + 1,
+                            std::memory_order_relaxed)) {
+                        new (&cell.storage) T(std::move(value));
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = enqueue.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// Does nothing because pushed values are visible to consumers immediately.
+        void publish() { }
+
+        /// Removes the oldest value from this queue unless it is empty.
+        Option<T> pop() {
+            auto position = dequeue.load(std::memory_order_relaxed);
+            while (true) {
+                auto& cell = cells[position & mask];
+                auto sequence = cell.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<intptr_t>(sequence - (position + 1));
+                if (difference == 0) {
+                    if (dequeue.compare_exchange_weak(position, position + 1,
+                            std::memory_order_relaxed)) {
+                        auto& slot = reinterpret_cast<T&>(cell.storage);
+                        Option<T> value{std::move(slot)};
+                        slot.~T();
+                        cell.sequence.store(position + mask + 1, std::memory_order_release);
+                        return value;
+                    }
+                } else if (difference < 0) {
+                    return {};
+                } else {
+                    position = dequeue.load(std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    /// The state shared by the senders and receivers of a channel.
+    template <class Q>
+    struct Channel {
+        Q queue;
+        std::atomic<size_t> senders{1};
+        std::atomic<size_t> receivers{1};
+        /// Blocks receivers until values are sent or every sender is dropped.
+        Parker readable;
+        /// Blocks senders until values are received or every receiver is dropped.
+        Parker writable;
+
+        explicit Channel(size_t capacity) : queue{capacity} { }
+    };
+}
+
+/// The sending side of a channel.
+///
+/// The senders of a multiple-producer channel may be copied.
+template <class T, class Q>
+class Sender {
+    /// The number of values sent by `send_all` between publications.
+    static constexpr size_t BATCH = 64;
+
+    std::shared_ptr<detail::Channel<Q>> channel;
+
+    /// Moves the supplied value into the queue, blocking while it is full.
+    ///
+    /// Returns `false` if every receiver was dropped before there was room for the value.
+    bool push(T& value) {
+        auto& queue = channel->queue;
+        if (VCE_LIKELY(queue.push(value))) {
+            return true;
+        }
+
+        queue.publish();
+        channel->readable.notify();
+        auto pushed = false;
+        channel->writable.wait([&] {
+            pushed = queue.push(value);
+            return pushed || channel->receivers.load(std::memory_order_acquire) == 0;
+        });
+        return pushed;
+    }
+
+public:
+    explicit Sender(std::shared_ptr<detail::Channel<Q>> channel) : channel{std::move(channel)} { }
+
+    Sender(const Sender& other) : channel{other.channel} {
+        static_assert(Q::MULTIPLE, "the sender of a single-producer channel can't be copied");
+        channel->senders.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Sender(Sender&& other) noexcept = default;
+
+    Sender& operator=(Sender other) noexcept {
+        std::swap(channel, other.channel);
+        return *this;
+    }
+
+    /// Closes the channel if this is the last sender.
+    ~Sender() {
+        if (channel && channel->senders.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            channel->readable.notify();
+        }
+    }
+
+    /// Sends the supplied value, blocking while the channel is full.
+    ///
+    /// Returns the value as an error if every receiver has been dropped.
+    Result<Unit, T> send(T value) {
+        if (channel->receivers.load(std::memory_order_acquire) == 0 || !push(value)) {
+            return {ERR, std::move(value)};
+        }
+        channel->queue.publish();
+        channel->readable.notify();
+        return {OK, Unit{}};
+    }
+
+    /// Sends the items emitted by the supplied iterator, blocking while the channel is full, and
+    /// returns the number of items sent.
+    ///
+    /// The items are made visible to receivers and the receivers are woken in batches rather than
+    /// after every item. Stops once every receiver has been dropped.
+    template <class I>
+    size_t send_all(I iterator) {
+        size_t sent = 0;
+        if (channel->receivers.load(std::memory_order_acquire) != 0) {
+            for (auto item : iterator) {
+                T value(std::move(item));
+                if (!push(value)) {
+                    break;
+                }
+                sent += 1;
+                if (sent % BATCH == 0) {
+                    channel->queue.publish();
+                    channel->readable.notify();
+                }
+            }
+        }
+        channel->queue.publish();
+        channel->readable.notify();
+        return sent;
+    }
+};
+
+/// The receiving side of a channel, which is an iterator over the values sent to the channel.
+///
+/// The iterator blocks until a value is received and ends once every sender has been dropped and
+/// every value sent has been received. The receivers of a multiple-consumer channel may be copied.
+template <class T, class Q>
+class Receiver : public Iterator<T, Receiver<T, Q>> {
+    std::shared_ptr<detail::Channel<Q>> channel;
+
+protected:
+    Bounds bounds_impl() const {
+        return {0};
+    }
+
+    Option<T> next_impl() {
+        auto value = channel->queue.pop();
+        if (VCE_LIKELY(value.is_some())) {
+            channel->writable.notify();
+            return value;
+        }
+
+        auto closed = false;
+        channel->readable.wait([&] {
+            value = channel->queue.pop();
+            closed = channel->senders.load(std::memory_order_acquire) == 0;
+            return value.is_some() || closed;
+        });
+
+        // Values sent before the last sender was dropped are received before the iterator ends.
+        if (value.is_none() && closed) {
+            value = channel->queue.pop();
+        }
+        if (value.is_some()) {
+            channel->writable.notify();
+        }
+        return value;
+    }
+
+public:
+    explicit Receiver(std::shared_ptr<detail::Channel<Q>> channel)
+        : channel{std::move(channel)} { }
+
+    Receiver(const Receiver& other) : channel{other.channel} {
+        static_assert(Q::MULTIPLE, "the receiver of a single-consumer channel can't be copied");
+        channel->receivers.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Receiver(Receiver&& other) noexcept = default;
+
+    Receiver& operator=(Receiver other) noexcept {
+        std::swap(channel, other.channel);
+        return *this;
+    }
+
+    /// Disconnects the senders if this is the last receiver.
+    ~Receiver() {
+        if (channel && channel->receivers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            channel->writable.notify();
+        }
+    }
+
+    /// Receives a value if one is available without blocking.
+    Option<T> try_next() {
+        auto value = channel->queue.pop();
+        if (value.is_some()) {
+            channel->writable.notify();
+        }
+        return value;
+    }
+};
+
+/// The sending side of a single-producer single-consumer channel.
+template <class T>
+using SpscSender = Sender<T, detail::SpscQueue<T>>;
+
+/// The receiving side of a single-producer single-consumer channel.
+template <class T>
+using SpscReceiver = Receiver<T, detail::SpscQueue<T>>;
+
+/// The sending side of a multiple-producer multiple-consumer channel.
+template <class T>
+using MpmcSender = Sender<T, detail::MpmcQueue<T>>;
+
+/// The receiving side of a multiple-producer multiple-consumer channel.
+template <class T>
+using MpmcReceiver = Receiver<T, detail::MpmcQueue<T>>;
+
+/// Returns the sender and receiver of a bounded lock-free channel with a single producer and a
+/// single consumer which holds at least the supplied number of values.
+///
+/// Senders block while the channel is full and receivers block while it is empty, spinning briefly
+/// before they sleep. Panics if the capacity is zero.
+template <class T>
+std::pair<SpscSender<T>, SpscReceiver<T>> spsc_channel(size_t capacity) {
+    auto channel = std::make_shared<detail::Channel<detail::SpscQueue<T>>>(capacity);
+    return {SpscSender<T>{channel}, SpscReceiver<T>{channel}};
+}
+
+/// Returns the sender and receiver of a bounded lock-free channel with multiple producers and
+/// multiple consumers which holds at least the supplied number of values.
+///
+/// The sender and receiver may be copied to add producers and consumers. Senders block while the
+/// channel is full and receivers block while it is empty, spinning briefly before they sleep.
+/// Panics if the capacity is zero.
+template <class T>
+std::pair<MpmcSender<T>, MpmcReceiver<T>> mpmc_channel(size_t capacity) {
+    auto channel = std::make_shared<detail::Channel<detail::MpmcQueue<T>>>(capacity);
+    return {MpmcSender<T>{channel}, MpmcReceiver<T>{channel}};
+}
+
+}
+
+#endif
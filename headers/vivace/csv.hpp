@@ -0,0 +1,321 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_CSV_HPP
+#define VCE_CSV_HPP
+
+#include <vivace/io.hpp>
+
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vce {
+
+/// An error which occurred while tokenizing delimited text.
+class CsvError {
+public:
+    /// A kind of error which occurred while tokenizing delimited text.
+    enum class Kind {
+        /// A quoted field was not closed before the end of the text.
+        UnterminatedQuote,
+        /// A quote appeared inside an unquoted field or a closing quote was not followed by a
+        /// delimiter or the end of the row.
+        InvalidQuote,
+        /// The source of the text failed.
+        Io,
+    };
+
+private:
+    Kind kind_;
+    size_t row_;
+    int code_;
+
+public:
+    /// Constructs an error of the supplied kind which occurred in the row at the supplied index.
+    CsvError(Kind kind, size_t row) : kind_{kind}, row_{row}, code_{0} { }
+
+    /// Constructs an error for the supplied I/O error which occurred in the row at the supplied
+    /// index.
+    CsvError(IoError error, size_t row) : kind_{Kind::Io}, row_{row}, code_{error.code()} { }
+
+    /// Returns the kind of this error.
+    Kind kind() const {
+        return kind_;
+    }
+
+    /// Returns the index of the row in which this error occurred.
+    size_t row() const {
+        return row_;
+    }
+
+    /// Returns the I/O error which caused this error, if any.
+    Option<IoError> io() const {
+        if (kind_ == Kind::Io) {
+            return {IoError{code_}};
+        } else {
+            return {};
+        }
+    }
+
+    friend bool operator==(const CsvError& left, const CsvError& right) {
+        return left.kind_ == right.kind_ && left.row_ == right.row_ && left.code_ == right.code_;
+    }
+
+    friend bool operator!=(const CsvError& left, const CsvError& right) {
+        return !(left == right);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const CsvError& error);
+};
+
+namespace detail {
+    /// Tokenizes rows of delimited text into fields.
+    ///
+    /// The fields of the last row parsed are kept in buffers which are reused for every row.
+    class CsvParser {
+        char delimiter;
+        std::vector<std::string_view> fields;
+        /// The indices of the fields which contain escaped quotes.
+        std::vector<size_t> escaped;
+        /// The storage for the fields which contain escaped quotes once they are unescaped.
+        std::string scratch;
+
+        void unescape();
+
+    public:
+        /// The outcome of parsing a row.
+        enum class Status { Row, Incomplete, Error };
+
+        /// The outcome of parsing a row and the number of bytes that make up the row or the kind
+        /// of error which occurred.
+        struct Step {
+            Status status;
+            size_t consumed;
+            CsvError::Kind error;
+        };
+
+        explicit CsvParser(char delimiter) : delimiter{delimiter} { }
+
+        /// Parses the row at the start of the supplied text.
+        ///
+        /// If the text is not known to be the last of the input, a row which reaches the end of
+        /// the text is incomplete.
+        Step parse(std::string_view text, bool last);
+
+        /// Returns the fields of the last row parsed.
+        Span<const std::string_view> row() const {
+            return {fields.data(), fields.size()};
+        }
+    };
+}
+
+/// The type of items emitted by the iterators over rows of delimited text.
+using CsvRow = Result<Span<const std::string_view>, CsvError>;
+
+/// An iterator over the rows of delimited text.
+class CsvIterator : public Iterator<CsvRow, CsvIterator> {
+    std::string_view rest;
+    detail::CsvParser parser;
+    size_t row;
+    bool finished;
+
+protected:
+    Bounds bounds_impl() const {
+        return {0, finished ? 0 : rest.size()};
+    }
+
+    Option<CsvRow> next_impl() {
+        if (finished || rest.empty()) {
+            return {};
+        }
+        auto step = parser.parse(rest, true);
+        if (step.status == detail::CsvParser::Status::Error) {
+            finished = true;
+            return {CsvRow{ERR, CsvError{step.error, row}}};
+        }
+        rest.remove_prefix(step.consumed);
+        row += 1;
+        return {CsvRow{OK, parser.row()}};
+    }
+
+public:
+    /// Constructs an iterator over the rows of the supplied text.
+    CsvIterator(std::string_view text, char delimiter)
+        : rest{text}, parser{delimiter}, row{0}, finished{false} { }
+};
+
+/// An iterator over the rows of delimited text emitted by an iterator over lines or chunks.
+template <class I>
+class CsvSourceIterator : public Iterator<CsvRow, CsvSourceIterator<I>> {
+    static constexpr bool LINES = std::is_convertible_v<typename I::item_t, std::string_view>;
+
+    /// The minimum number of bytes of a chunk copied after a partial row from a previous chunk.
+    static constexpr size_t EXTENSION = 4096;
+
+    I source;
+    detail::CsvParser parser;
+    size_t row;
+    bool finished;
+
+    /// The current chunk which is valid until the next chunk is requested.
+    std::string_view chunk;
+    /// A partial row from a previous chunk followed by a prefix of the current chunk.
+    std::string work;
+    /// The number of bytes of the current chunk copied into the work buffer.
+    size_t taken;
+    /// The text which has yet to be parsed.
+    std::string_view window;
+    bool in_work;
+    bool eof;
+
+    Option<CsvRow> fail(CsvError error) {
+        finished = true;
+        return {CsvRow{ERR, error}};
+    }
+
+    Option<CsvRow> next_line() {
+        auto line = source.next();
+        if (line.is_none()) {
+            finished = true;
+            return {};
+        }
+        auto step = parser.parse(line.unwrap(), true);
+        if (step.status == detail::CsvParser::Status::Error) {
+            return fail({step.error, row});
+        }
+        row += 1;
+        return {CsvRow{OK, parser.row()}};
+    }
+
+    Option<CsvRow> next_chunked() {
+        while (true) {
+            if (!window.empty()) {
+                auto step = parser.parse(window, eof);
+                if (step.status == detail::CsvParser::Status::Row) {
+                    window.remove_prefix(step.consumed);
+                    // Parsing moves back to the current chunk once the partial row is complete.
+                    if (in_work && window.size() <= taken) {
+                        window = chunk.substr(taken - window.size());
+                        in_work = false;
+                    }
+                    row += 1;
+                    return {CsvRow{OK, parser.row()}};
+                } else if (step.status == detail::CsvParser::Status::Error) {
+                    return fail({step.error, row});
+                }
+            } else if (eof) {
+                finished = true;
+                return {};
+            }
+
+            // The rest of the window is a partial row which is completed with more of the
+            // current chunk if there is any or with the next chunk otherwise.
+            if (in_work) {
+                work.erase(0, work.size() - window.size());
+            } else {
+                work.assign(window);
+            }
+            if (in_work && taken < chunk.size()) {
+                extend();
+                continue;
+            }
+
+            auto next = source.next();
+            if (next.is_none()) {
+                eof = true;
+                chunk = {};
+            } else {
+                auto bytes = next.unwrap();
+                if (bytes.is_err()) {
+                    return fail({bytes.unwrap_err(), row});
+                }
+                auto span = bytes.unwrap();
+                chunk = {reinterpret_cast<const char*>(span.data()), span.size()};
+            }
+            taken = 0;
+
+            if (work.empty()) {
+                window = chunk;
+                in_work = false;
+            } else {
+                extend();
+            }
+        }
+    }
+
+    /// Copies more of the current chunk into the work buffer.
+    void extend() {
+        auto size = std::min(chunk.size() - taken, std::max(work.size(), EXTENSION));
+        work.append(chunk.data() + taken, size);
+        taken += size;
+        window = work;
+        in_work = true;
+    }
+
+protected:
+    Bounds bounds_impl() const {
+        return {0};
+    }
+
+    Option<CsvRow> next_impl() {
+        if (finished) {
+            return {};
+        } else if constexpr (LINES) {
+            return next_line();
+        } else {
+            return next_chunked();
+        }
+    }
+
+public:
+    /// Constructs an iterator over the rows of the text emitted by the supplied iterator.
+    CsvSourceIterator(I source, char delimiter)
+        : source{std::move(source)},
+          parser{delimiter},
+          row{0},
+          finished{false},
+          taken{0},
+          in_work{false},
+          eof{false} { }
+};
+
+/// Returns an iterator over the rows of the supplied delimited text.
+///
+/// Fields are separated by the delimiter and rows by `\n` or `\r\n`, and a `\r` which ends the text
+/// is ignored. A field may be enclosed in double quotes in which case it may contain delimiters,
+/// newlines and quotes escaped by doubling them. The fields of each row are views of the text,
+/// except for fields with escaped quotes which are unescaped into a buffer, and are valid until the
+/// next row is requested. An error is emitted in place of a malformed row after which the iterator
+/// ends.
+inline CsvIterator csv_rows(std::string_view text, char delimiter = ',') {
+    return {text, delimiter};
+}
+
+/// Returns an iterator over the rows of the delimited text emitted by the supplied iterator.
+///
+/// The iterator may emit lines as string views, in which case each line is a row and quoted fields
+/// can't contain newlines, or chunks of bytes like those emitted by `read_chunks`, in which case
+/// rows may span chunks. Rows within a chunk are tokenized in place and only rows which span chunks
+/// are copied.
+template <class I, Sfinae<std::is_base_of_v<Iterator<typename I::item_t, I>, I>> = 0>
+CsvSourceIterator<I> csv_rows(I source, char delimiter = ',') {
+    return {std::move(source), delimiter};
+}
+
+}
+
+#endif
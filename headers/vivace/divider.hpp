@@ -0,0 +1,162 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_DIVIDER_HPP
+#define VCE_DIVIDER_HPP
+
+#include <vivace/math.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace vce {
+
+template <class T>
+class Divider;
+
+template <class T>
+Option<Divider<T>> divider(T divisor);
+
+namespace detail {
+    /// Returns the high half of the product of the two supplied values.
+    template <class T>
+    constexpr T mul_high(T left, T right) {
+        return static_cast<T>(widening_mul(left, right) >> (8 * sizeof(T)));
+    }
+
+    /// Returns the base 2 logarithm of the supplied value rounded up.
+    inline uint32_t log2_ceil(uint64_t value) {
+        return value <= 1 ? 0 : 64 - static_cast<uint32_t>(__builtin_clzll(value - 1));
+    }
+}
+
+/// Divides integers by a non-zero divisor which is fixed at runtime without dividing.
+///
+/// The quotients are computed by multiplying by a precomputed reciprocal of the divisor and
+/// shifting the high half of the product as described by Granlund and Montgomery in "Division by
+/// Invariant Integers using Multiplication".
+template <class T>
+class Divider {
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "T must be an integer");
+
+    template <class U>
+    friend Option<Divider<U>> divider(U divisor);
+
+    static constexpr uint32_t BITS = 8 * sizeof(T);
+
+    T divisor_;
+    T multiplier;
+    uint8_t first;
+    uint8_t second;
+
+    Divider(T divisor, T multiplier, uint32_t first, uint32_t second) :
+        divisor_{divisor},
+        multiplier{multiplier},
+        first{static_cast<uint8_t>(first)},
+        second{static_cast<uint8_t>(second)} { }
+
+    /// Returns a divider for the supplied non-zero divisor.
+    static Divider<T> create(T divisor) {
+        using U = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T>) {
+            auto negative = divisor < static_cast<T>(0);
+            auto magnitude = static_cast<U>(negative ? U{0} - static_cast<U>(divisor) : divisor);
+            auto log2 = std::max<uint32_t>(detail::log2_ceil(magnitude), 1);
+            // The multiplier is 2^BITS too large to be represented and the excess is restored by
+            // adding the dividend to the high half of the product.
+            auto multiplier = (static_cast<Uint128>(1) << (BITS + log2 - 1)) / magnitude + 1;
+            return {divisor, static_cast<T>(static_cast<U>(multiplier)), log2 - 1, 0};
+        } else {
+            auto log2 = detail::log2_ceil(divisor);
+            auto excess = ((static_cast<Uint128>(1) << log2) - divisor) << BITS;
+            auto multiplier = excess / divisor + 1;
+            return {divisor, static_cast<T>(multiplier), std::min<uint32_t>(log2, 1),
+                    std::max<uint32_t>(log2, 1) - 1};
+        }
+    }
+public:
+    /// Returns the divisor of this divider.
+    T divisor() const {
+        return divisor_;
+    }
+
+    /// Returns the quotient of the supplied value and the divisor of this divider.
+    ///
+    /// The quotient wraps around at the bounds of the type if it overflows.
+    T div(T value) const {
+        auto high = detail::mul_high(multiplier, value);
+        if constexpr (std::is_signed_v<T>) {
+            auto quotient = static_cast<T>(wrapping_add(value, high) >> first);
+            quotient = wrapping_sub(quotient, static_cast<T>(value >> (BITS - 1)));
+            auto sign = static_cast<T>(divisor_ >> (BITS - 1));
+            return wrapping_sub(static_cast<T>(quotient ^ sign), sign);
+        } else {
+            return static_cast<T>((high + static_cast<T>((value - high) >> first)) >> second);
+        }
+    }
+
+    /// Returns the remainder of the supplied value and the divisor of this divider.
+    T rem(T value) const {
+        return wrapping_sub(value, wrapping_mul(div(value), divisor_));
+    }
+
+    /// Returns the quotient of the supplied value and the divisor of this divider unless the
+    /// quotient overflows.
+    Option<T> checked_div(T value) const {
+        if (!detail::invalid_division(value, divisor_)) {
+            return {div(value)};
+        } else {
+            return {};
+        }
+    }
+
+    /// Stores the quotients of the values in the supplied view and the divisor of this divider in
+    /// the supplied output view.
+    ///
+    /// Only as many values as fit in the shorter view are divided.
+    void div(Span<const T> values, Span<T> out) const {
+        auto size = std::min(values.size(), out.size());
+        auto divider = *this;
+        for (size_t i = 0; i < size; ++i) {
+            out[i] = divider.div(values[i]);
+        }
+    }
+
+    /// Stores the remainders of the values in the supplied view and the divisor of this divider in
+    /// the supplied output view.
+    ///
+    /// Only as many values as fit in the shorter view are divided.
+    void rem(Span<const T> values, Span<T> out) const {
+        auto size = std::min(values.size(), out.size());
+        auto divider = *this;
+        for (size_t i = 0; i < size; ++i) {
+            out[i] = divider.rem(values[i]);
+        }
+    }
+};
+
+/// Returns a divider for the supplied divisor unless the divisor is zero.
+template <class T>
+Option<Divider<T>> divider(T divisor) {
+    if (divisor != static_cast<T>(0)) {
+        return {Divider<T>::create(divisor)};
+    } else {
+        return {};
+    }
+}
+
+}
+
+#endif
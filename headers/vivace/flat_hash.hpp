@@ -0,0 +1,632 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_FLAT_HASH_HPP
+#define VCE_FLAT_HASH_HPP
+
+#include <vivace/hash.hpp>
+#include <vivace/simd.hpp>
+#include <vivace/vec.hpp>
+
+#include <functional>
+#include <iterator>
+#include <limits>
+
+namespace vce {
+
+namespace detail {
+    /// The control byte of a slot which has never contained an item.
+    static constexpr int8_t CTRL_EMPTY = -128;
+    /// The control byte of a slot whose item has been erased.
+    static constexpr int8_t CTRL_DELETED = -2;
+    /// The control byte which follows the last slot and terminates iteration.
+    static constexpr int8_t CTRL_SENTINEL = -1;
+
+    /// The number of control bytes which are probed at once.
+    static constexpr size_t GROUP_WIDTH = 16;
+
+    /// A group of control bytes which are compared in parallel.
+    ///
+    /// The control byte of a slot that contains an item is the low seven bits of the hash of the
+    /// item so a single comparison filters out almost every slot that can't match.
+    class Group {
+        typedef int8_t type __attribute__((vector_size(GROUP_WIDTH)));
+
+        type ctrl;
+
+        static type splat(int8_t value) {
+            type vector = {};
+            return vector + value;
+        }
+
+        static uint32_t mask(type vector) {
+#if defined(__SSE2__)
+            return static_cast<uint32_t>(_mm_movemask_epi8((__m128i)vector));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+                mask |= static_cast<uint32_t>(vector[i] != 0) << i;
+            }
+            return mask;
+#endif
+        }
+
+    public:
+        /// Loads the group of control bytes starting at the supplied address.
+        explicit Group(const int8_t* ctrl) {
+            std::memcpy(&this->ctrl, ctrl, sizeof(this->ctrl));
+        }
+
+        /// Returns a mask of the control bytes in this group equal to the supplied control byte.
+        uint32_t match(int8_t h2) const {
+            return mask(ctrl == splat(h2));
+        }
+
+        /// Returns a mask of the empty control bytes in this group.
+        uint32_t match_empty() const {
+            return match(CTRL_EMPTY);
+        }
+
+        /// Returns a mask of the empty or deleted control bytes in this group.
+        uint32_t match_empty_or_deleted() const {
+            return mask(ctrl < splat(CTRL_SENTINEL));
+        }
+
+        /// Returns the number of empty or deleted control bytes at the start of this group.
+        uint32_t count_leading_empty_or_deleted() const {
+            return __builtin_ctz(~match_empty_or_deleted());
+        }
+    };
+
+    /// Returns the position in the probe sequence of the supplied hash.
+    inline size_t h1(size_t hash) {
+        return hash >> 7;
+    }
+
+    /// Returns the control byte of a slot containing an item with the supplied hash.
+    inline int8_t h2(size_t hash) {
+        return static_cast<int8_t>(hash & 0x7F);
+    }
+
+    /// Extracts the key from an item in a hash set.
+    struct SetKey {
+        template <class T>
+        static const T& key(const T& item) {
+            return item;
+        }
+    };
+
+    /// Extracts the key from an item in a hash map.
+    struct MapKey {
+        template <class T>
+        static const auto& key(const T& item) {
+            return item.first;
+        }
+    };
+
+    /// An iterator over the occupied slots in a hash table.
+    template <class T>
+    class FlatCursor {
+        template <class, class, class, class, class>
+        friend class FlatTable;
+
+        template <class>
+        friend class FlatCursor;
+
+        const int8_t* ctrl;
+        T* slot;
+
+        FlatCursor(const int8_t* ctrl, T* slot) : ctrl{ctrl}, slot{slot} { }
+
+        void skip() {
+            while (*ctrl < CTRL_SENTINEL) {
+                auto shift = Group{ctrl}.count_leading_empty_or_deleted();
+                ctrl += shift;
+                slot += shift;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        FlatCursor() : ctrl{nullptr}, slot{nullptr} { }
+
+        operator FlatCursor<const T>() const {
+            return {ctrl, slot};
+        }
+
+        T& operator*() const {
+            return *slot;
+        }
+
+        T* operator->() const {
+            return slot;
+        }
+
+        FlatCursor& operator++() {
+            ++ctrl;
+            ++slot;
+            skip();
+            return *this;
+        }
+
+        FlatCursor operator++(int) {
+            auto previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(FlatCursor left, FlatCursor right) {
+            return left.slot == right.slot;
+        }
+
+        friend bool operator!=(FlatCursor left, FlatCursor right) {
+            return left.slot != right.slot;
+        }
+    };
+
+    /// An open addressing hash table which stores its items inline and probes groups of control
+    /// bytes with SIMD comparisons.
+    ///
+    /// The table has one less slot than a power of two and is followed by a sentinel control byte
+    /// and a copy of the first `GROUP_WIDTH - 1` control bytes so that a group can be loaded at
+    /// any slot without wrapping around. At most seven eighths of the slots are occupied.
+    template <class T, class K, class P, class H, class E>
+    class FlatTable {
+        static_assert(
+            alignof(T) <= alignof(std::max_align_t), "over-aligned items are not supported");
+
+        int8_t* ctrl_;
+        T* slots;
+        size_t size_;
+        size_t capacity_;
+        size_t growth_left;
+
+    public:
+        using key_type = K;
+        using value_type = T;
+        using size_type = size_t;
+        using hasher = H;
+        using key_equal = E;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = FlatCursor<T>;
+        using const_iterator = FlatCursor<const T>;
+
+        /// Whether this type may be safely moved to another location in memory.
+        static constexpr bool RELOCATABLE = true;
+
+        /// Constructs an empty table.
+        FlatTable() : ctrl_{nullptr}, slots{nullptr}, size_{0}, capacity_{0}, growth_left{0} { }
+
+        /// Constructs a table containing the supplied items.
+        FlatTable(std::initializer_list<T> list) : FlatTable{} {
+            reserve(list.size());
+            for (const auto& item : list) {
+                insert(item);
+            }
+        }
+
+        FlatTable(const FlatTable& other) : FlatTable{} {
+            copy(other);
+        }
+
+        FlatTable& operator=(const FlatTable& other) {
+            if (this != &other) {
+                clear();
+                copy(other);
+            }
+            return *this;
+        }
+
+        FlatTable(FlatTable&& other) noexcept : FlatTable{} {
+            steal(other);
+        }
+
+        FlatTable& operator=(FlatTable&& other) noexcept {
+            if (this != &other) {
+                destroy();
+                steal(other);
+            }
+            return *this;
+        }
+
+        ~FlatTable() {
+            destroy();
+        }
+
+        /// Returns the number of items in this table.
+        size_t size() const {
+            return size_;
+        }
+
+        /// Returns the number of slots in this table.
+        size_t capacity() const {
+            return capacity_;
+        }
+
+        /// Returns whether this table contains no items.
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        iterator begin() {
+            return at<T>(0, true);
+        }
+
+        const_iterator begin() const {
+            return at<const T>(0, true);
+        }
+
+        iterator end() {
+            return at<T>(capacity_, false);
+        }
+
+        const_iterator end() const {
+            return at<const T>(capacity_, false);
+        }
+
+        /// Ensures this table can contain at least the supplied number of items without rehashing.
+        void reserve(size_t size) {
+            if (size > capacity_ - capacity_ / 8) {
+                resize(capacity_for(size));
+            }
+        }
+
+        /// Inserts the supplied item if this table does not contain an item with an equal key.
+        ///
+        /// Returns the item with an equal key and whether the supplied item was inserted.
+        std::pair<iterator, bool> insert(T item) {
+            const auto& key = P::key(item);
+            auto hash = static_cast<size_t>(H{}(key));
+            auto index = find_index(key, hash);
+            if (index != capacity_) {
+                return {at<T>(index, false), false};
+            }
+            index = construct(hash, std::move(item));
+            return {at<T>(index, false), true};
+        }
+
+        /// Returns the item with a key equal to the supplied key, if any.
+        iterator find(const K& key) {
+            return at<T>(find_index(key), false);
+        }
+
+        /// Returns the item with a key equal to the supplied key, if any.
+        const_iterator find(const K& key) const {
+            return at<const T>(find_index(key), false);
+        }
+
+        /// Returns whether this table contains an item with a key equal to the supplied key.
+        bool contains(const K& key) const {
+            return find_index(key) != capacity_;
+        }
+
+        /// Returns the number of items in this table with a key equal to the supplied key.
+        size_t count(const K& key) const {
+            return contains(key) ? 1 : 0;
+        }
+
+        /// Removes the item with a key equal to the supplied key and returns whether there was one.
+        bool erase(const K& key) {
+            auto index = find_index(key);
+            if (index == capacity_) {
+                return false;
+            }
+
+            slots[index].~T();
+            size_ -= 1;
+
+            // A slot can be emptied rather than deleted if no group containing it was ever full
+            // since no probe sequence can have passed over it.
+            auto before = Group{ctrl_ + ((index - GROUP_WIDTH) & capacity_)}.match_empty();
+            auto after = Group{ctrl_ + index}.match_empty();
+            auto gap = GROUP_WIDTH;
+            if (before != 0 && after != 0) {
+                gap = (__builtin_clz(before) - (32 - GROUP_WIDTH)) + __builtin_ctz(after);
+            }
+            if (gap < GROUP_WIDTH) {
+                set_ctrl(index, CTRL_EMPTY);
+                growth_left += 1;
+            } else {
+                set_ctrl(index, CTRL_DELETED);
+            }
+            return true;
+        }
+
+        /// Removes all of the items in this table without releasing its memory.
+        void clear() {
+            if (capacity_ != 0) {
+                destroy_items();
+                reset_ctrl();
+                size_ = 0;
+                growth_left = capacity_ - capacity_ / 8;
+            }
+        }
+
+        /// Returns whether the supplied tables contain equal items.
+        friend bool operator==(const FlatTable& left, const FlatTable& right) {
+            if (left.size_ != right.size_) {
+                return false;
+            }
+            for (const auto& item : left) {
+                auto other = right.find(P::key(item));
+                if (other == right.end() || !(*other == item)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        friend bool operator!=(const FlatTable& left, const FlatTable& right) {
+            return !(left == right);
+        }
+
+    protected:
+        /// Returns the index of the item with a key equal to the supplied key or the capacity of
+        /// this table if there is no such item.
+        size_t find_index(const K& key) const {
+            return find_index(key, static_cast<size_t>(H{}(key)));
+        }
+
+        /// Returns the index of the item with a key equal to the supplied key and the supplied
+        /// hash or the capacity of this table if there is no such item.
+        size_t find_index(const K& key, size_t hash) const {
+            if (capacity_ == 0) {
+                return capacity_;
+            }
+            auto h2 = detail::h2(hash);
+            auto offset = h1(hash) & capacity_;
+            for (auto stride = GROUP_WIDTH; ; stride += GROUP_WIDTH) {
+                Group group{ctrl_ + offset};
+                for (auto mask = group.match(h2); mask != 0; mask &= mask - 1) {
+                    auto index = (offset + __builtin_ctz(mask)) & capacity_;
+                    if (VCE_LIKELY(E{}(P::key(slots[index]), key))) {
+                        return index;
+                    }
+                }
+                if (group.match_empty() != 0) {
+                    return capacity_;
+                }
+                offset = (offset + stride) & capacity_;
+            }
+        }
+
+        /// Constructs an item from the supplied arguments in a free slot for the supplied hash.
+        ///
+        /// This table must not contain an item with a key equal to the key of the new item.
+        template <class... N>
+        size_t construct(size_t hash, N&&... arguments) {
+            auto index = capacity_ != 0 ? find_free(hash) : 0;
+            auto reuse = capacity_ != 0 && ctrl_[index] == CTRL_DELETED;
+            if (VCE_UNLIKELY(growth_left == 0 && !reuse)) {
+                rehash();
+                index = find_free(hash);
+            }
+
+            new(slots + index) T(std::forward<N>(arguments)...);
+            growth_left -= ctrl_[index] == CTRL_EMPTY ? 1 : 0;
+            set_ctrl(index, h2(hash));
+            size_ += 1;
+            return index;
+        }
+
+        /// Returns an iterator starting at the supplied slot.
+        template <class U>
+        FlatCursor<U> at(size_t index, bool skip) const {
+            FlatCursor<U> cursor{ctrl_ + index, slots + index};
+            if (skip && capacity_ != 0) {
+                cursor.skip();
+            }
+            return cursor;
+        }
+
+    private:
+        static size_t capacity_for(size_t size) {
+            if (size > std::numeric_limits<size_t>::max() / 16) {
+                throw std::bad_alloc{};
+            }
+            size_t capacity = GROUP_WIDTH - 1;
+            while (capacity - capacity / 8 < size) {
+                capacity = capacity * 2 + 1;
+            }
+            return capacity;
+        }
+
+        /// Returns the offset of the slots from the start of the control bytes.
+        static size_t slots_offset(size_t capacity) {
+            auto bytes = capacity + GROUP_WIDTH;
+            return (bytes + alignof(T) - 1) & ~(alignof(T) - 1);
+        }
+
+        size_t find_free(size_t hash) const {
+            auto offset = h1(hash) & capacity_;
+            for (auto stride = GROUP_WIDTH; ; stride += GROUP_WIDTH) {
+                auto mask = Group{ctrl_ + offset}.match_empty_or_deleted();
+                if (mask != 0) {
+                    return (offset + __builtin_ctz(mask)) & capacity_;
+                }
+                offset = (offset + stride) & capacity_;
+            }
+        }
+
+        void set_ctrl(size_t index, int8_t ctrl) {
+            ctrl_[index] = ctrl;
+            ctrl_[((index - (GROUP_WIDTH - 1)) & capacity_) + (GROUP_WIDTH - 1)] = ctrl;
+        }
+
+        void reset_ctrl() {
+            std::memset(ctrl_, CTRL_EMPTY, capacity_ + GROUP_WIDTH);
+            ctrl_[capacity_] = CTRL_SENTINEL;
+        }
+
+        void rehash() {
+            // Deleted slots are reclaimed in place if they make up a large part of the table.
+            if (capacity_ != 0 && size_ <= capacity_ / 2 - capacity_ / 16) {
+                resize(capacity_);
+            } else {
+                resize(capacity_ != 0 ? capacity_ * 2 + 1 : GROUP_WIDTH - 1);
+            }
+        }
+
+        void resize(size_t capacity) {
+            auto offset = slots_offset(capacity);
+            auto bytes = checked_add(offset, detail::bytes<T>(capacity)).unwrap_or_else(
+                []() -> size_t { throw std::bad_alloc{}; });
+            auto memory = static_cast<char*>(std::malloc(bytes));
+            if (memory == nullptr) {
+                throw std::bad_alloc{};
+            }
+
+            auto ctrl = ctrl_;
+            auto slots = this->slots;
+            auto previous = capacity_;
+            ctrl_ = reinterpret_cast<int8_t*>(memory);
+            this->slots = reinterpret_cast<T*>(memory + offset);
+            capacity_ = capacity;
+            growth_left = capacity - capacity / 8 - size_;
+            reset_ctrl();
+
+            for (size_t i = 0; i < previous; ++i) {
+                if (ctrl[i] >= 0) {
+                    auto hash = static_cast<size_t>(H{}(P::key(slots[i])));
+                    auto index = find_free(hash);
+                    set_ctrl(index, h2(hash));
+                    detail::relocate(slots + i, 1, this->slots + index);
+                }
+            }
+            std::free(ctrl);
+        }
+
+        void copy(const FlatTable& other) {
+            reserve(other.size_);
+            for (const auto& item : other) {
+                construct(static_cast<size_t>(H{}(P::key(item))), item);
+            }
+        }
+
+        void steal(FlatTable& other) {
+            ctrl_ = other.ctrl_;
+            slots = other.slots;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            growth_left = other.growth_left;
+            other.ctrl_ = nullptr;
+            other.slots = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+            other.growth_left = 0;
+        }
+
+        void destroy_items() {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (auto& item : *this) {
+                    item.~T();
+                }
+            }
+        }
+
+        void destroy() {
+            destroy_items();
+            std::free(ctrl_);
+            ctrl_ = nullptr;
+            slots = nullptr;
+            size_ = 0;
+            capacity_ = 0;
+            growth_left = 0;
+        }
+    };
+}
+
+/// A hash set which stores its items inline in an open addressing table.
+///
+/// Lookups compare a group of 16 control bytes at once and usually touch a single cache line of
+/// items. Inserting or erasing items invalidates iterators and references to the items in the set.
+template <class T, class H = Hash, class E = std::equal_to<T>>
+class FlatHashSet : public detail::FlatTable<T, T, detail::SetKey, H, E> {
+    using Base = detail::FlatTable<T, T, detail::SetKey, H, E>;
+
+public:
+    using Base::Base;
+};
+
+/// A hash map which stores its keys and values inline in an open addressing table.
+///
+/// Lookups compare a group of 16 control bytes at once and usually touch a single cache line of
+/// entries. Inserting or erasing entries invalidates iterators and references to the entries in
+/// the map. The keys of entries must not be modified through iterators.
+template <class K, class V, class H = Hash, class E = std::equal_to<K>>
+class FlatHashMap : public detail::FlatTable<std::pair<K, V>, K, detail::MapKey, H, E> {
+    using Base = detail::FlatTable<std::pair<K, V>, K, detail::MapKey, H, E>;
+
+public:
+    using mapped_type = V;
+    using typename Base::iterator;
+
+    using Base::Base;
+
+    /// Inserts an entry with a value constructed from the supplied arguments if this map does not
+    /// contain an entry with an equal key.
+    ///
+    /// Returns the entry with an equal key and whether a new entry was inserted.
+    template <class... N>
+    std::pair<iterator, bool> try_emplace(K key, N&&... arguments) {
+        auto hash = static_cast<size_t>(H{}(key));
+        auto index = Base::find_index(key, hash);
+        if (index != this->capacity()) {
+            return {Base::template at<std::pair<K, V>>(index, false), false};
+        }
+        index = Base::construct(
+            hash,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<N>(arguments)...));
+        return {Base::template at<std::pair<K, V>>(index, false), true};
+    }
+
+    /// Returns the value for the supplied key, inserting a default constructed value if there is
+    /// no entry with an equal key.
+    V& operator[](K key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    /// Returns the value for the supplied key, if any.
+    Option<Ref<V>> get(const K& key) {
+        auto index = Base::find_index(key);
+        if (index != this->capacity()) {
+            return {std::ref(Base::template at<std::pair<K, V>>(index, false)->second)};
+        } else {
+            return {};
+        }
+    }
+
+    /// Returns the value for the supplied key, if any.
+    Option<Ref<const V>> get(const K& key) const {
+        auto index = Base::find_index(key);
+        if (index != this->capacity()) {
+            return {std::cref(Base::template at<const std::pair<K, V>>(index, false)->second)};
+        } else {
+            return {};
+        }
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,303 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_FORMAT_HPP
+#define VCE_FORMAT_HPP
+
+#include <vivace/iterator.hpp>
+#include <vivace/option.hpp>
+#include <vivace/result.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace vce {
+
+namespace detail {
+    VCE_HAS_FIELD(HasFormatSize, SIZE);
+
+    /// Formats values of a type by appending their representations to a writer.
+    ///
+    /// Formatters for types whose representations have a known maximum size define it as `SIZE`.
+    template <class T, class = void>
+    struct Formatter { };
+
+    template <bool B, size_t N, class... T>
+    struct WrapperSize { };
+
+    template <size_t N, class... T>
+    struct WrapperSize<true, N, T...> {
+        static constexpr size_t SIZE = N + std::max({Formatter<T>::SIZE...});
+    };
+
+    /// Defines the maximum size of the representation of a type which wraps a value of one of the
+    /// supplied types with the supplied number of characters if all of those types define one.
+    template <size_t N, class... T>
+    using FormatWrapper = WrapperSize<(HasFormatSizeV<Formatter<T>> && ...), N, T...>;
+
+    template <class T>
+    struct Formatter<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+        static constexpr size_t SIZE = [] {
+            using L = std::numeric_limits<T>;
+            if constexpr (std::is_same_v<T, bool>) {
+                return 5;
+            } else if constexpr (std::is_same_v<T, char>) {
+                return 1;
+            } else if constexpr (std::is_integral_v<T>) {
+                return L::digits10 + 1 + L::is_signed;
+            } else {
+                // A sign, a point and an exponent of at most five characters.
+                return L::max_digits10 + 8;
+            }
+        }();
+
+        template <class W>
+        static void format(W& writer, T value) {
+            if constexpr (std::is_same_v<T, bool>) {
+                writer.append(value ? "true" : "false", value ? 4 : 5);
+            } else if constexpr (std::is_same_v<T, char>) {
+                writer.append(&value, 1);
+            } else {
+                char digits[SIZE];
+                auto end = std::to_chars(digits, digits + SIZE, value).ptr;
+                writer.append(digits, static_cast<size_t>(end - digits));
+            }
+        }
+    };
+
+    template <class T>
+    struct Formatter<T, std::enable_if_t<std::is_convertible_v<const T&, std::string_view>>> {
+        template <class W>
+        static void format(W& writer, const T& value) {
+            std::string_view string{value};
+            writer.append(string.data(), string.size());
+        }
+    };
+
+    template <class T>
+    struct Formatter<T, std::enable_if_t<std::is_convertible_v<const T&, Span<const std::byte>>>> {
+        template <class W>
+        static void format(W& writer, const T& value) {
+            Span<const std::byte> bytes{value};
+            writer.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+    };
+
+    template <class T>
+    struct Formatter<std::reference_wrapper<T>> : Formatter<std::remove_const_t<T>> {
+        template <class W>
+        static void format(W& writer, std::reference_wrapper<T> value) {
+            Formatter<std::remove_const_t<T>>::format(writer, value.get());
+        }
+    };
+
+    template <class T>
+    struct Formatter<Option<T>> : FormatWrapper<6, T> {
+        template <class W>
+        static void format(W& writer, const Option<T>& option) {
+            if (option.is_some()) {
+                writer.append("Some(", 5);
+                Formatter<T>::format(writer, option.as_ref().unwrap().get());
+                writer.append(")", 1);
+            } else {
+                writer.append("None", 4);
+            }
+        }
+    };
+
+    template <class T, class E>
+    struct Formatter<Result<T, E>> : FormatWrapper<5, T, E> {
+        template <class W>
+        static void format(W& writer, const Result<T, E>& result) {
+            if (result.is_ok()) {
+                writer.append("Ok(", 3);
+                Formatter<T>::format(writer, result.as_ref().unwrap().get());
+            } else {
+                writer.append("Err(", 4);
+                Formatter<E>::format(writer, result.as_ref().unwrap_err().get());
+            }
+            writer.append(")", 1);
+        }
+    };
+
+    template <>
+    struct Formatter<Bounds> {
+        static constexpr size_t SIZE =
+            4 + Formatter<size_t>::SIZE + Formatter<Option<size_t>>::SIZE;
+
+        template <class W>
+        static void format(W& writer, Bounds bounds) {
+            writer.append("(", 1);
+            Formatter<size_t>::format(writer, bounds.lower);
+            writer.append(", ", 2);
+            Formatter<Option<size_t>>::format(writer, bounds.upper);
+            writer.append(")", 1);
+        }
+    };
+
+    template <>
+    struct Formatter<Ordering> {
+        static constexpr size_t SIZE = 7;
+
+        template <class W>
+        static void format(W& writer, Ordering ordering) {
+            switch (ordering) {
+            case Ordering::Less:
+                return writer.append("Less", 4);
+            case Ordering::Greater:
+                return writer.append("Greater", 7);
+            case Ordering::Equal:
+                return writer.append("Equal", 5);
+            default:
+                return writer.append("?", 1);
+            }
+        }
+    };
+
+    template <>
+    struct Formatter<Unit> {
+        static constexpr size_t SIZE = 2;
+
+        template <class W>
+        static void format(W& writer, Unit) {
+            writer.append("()", 2);
+        }
+    };
+
+    /// Writes characters to consecutive addresses.
+    struct PointerWriter {
+        char* cursor;
+
+        void append(const char* data, size_t size) {
+            std::memcpy(cursor, data, size);
+            cursor += size;
+        }
+    };
+
+    /// Appends the representation of the supplied value to the supplied writer.
+    template <class W, class T>
+    void format(W& writer, const T& value) {
+        Formatter<T>::format(writer, value);
+    }
+
+    /// Writes the items in the supplied iterator to the supplied writer, separated by the supplied
+    /// separator, until the writer fails.
+    template <class I, class W>
+    void write_items(I& iterator, W& writer, std::string_view separator) {
+        auto first = true;
+        for (auto item : iterator) {
+            if (!first) {
+                writer.write(separator);
+            }
+            first = false;
+            writer.write(unref(item));
+            if (VCE_UNLIKELY(writer.failed())) {
+                return;
+            }
+        }
+    }
+}
+
+/// The maximum number of characters in the representation of a value of the supplied type.
+///
+/// Only defined for types whose representations have a known maximum size such as numbers,
+/// `Bounds`, `Ordering`, `Unit` and options and results of such types.
+template <class T>
+constexpr size_t FORMAT_SIZE = detail::Formatter<T>::SIZE;
+
+/// A writer of the representations of values to a string.
+class StringWriter {
+    std::string& buffer;
+    size_t start;
+
+public:
+    /// Constructs a writer which appends to the supplied string.
+    explicit StringWriter(std::string& buffer) : buffer{buffer}, start{buffer.size()} { }
+
+    /// Returns whether an error has occurred, which is never.
+    bool failed() const {
+        return false;
+    }
+
+    /// Appends the representation of the supplied value.
+    template <class T>
+    void write(const T& value) {
+        detail::format(*this, value);
+    }
+
+    /// Appends the supplied bytes.
+    void append(const char* data, size_t size) {
+        buffer.append(data, size);
+    }
+
+    /// Returns the total number of bytes appended.
+    size_t flush() const {
+        return buffer.size() - start;
+    }
+};
+
+/// Writes the representation of the supplied value to the supplied buffer and returns a pointer to
+/// the character following the last character written.
+///
+/// The buffer must have room for `FORMAT_SIZE<T>` characters. The representations match those
+/// written by `operator<<` except that booleans are written as `true` or `false` and floating
+/// point numbers are written in the shortest form which round trips. No memory is allocated.
+template <class T>
+char* format_to(char* buffer, const T& value) {
+    static_assert(detail::HasFormatSizeV<detail::Formatter<T>>,
+        "values of this type don't have a maximum size");
+    detail::PointerWriter writer{buffer};
+    detail::Formatter<T>::format(writer, value);
+    return writer.cursor;
+}
+
+/// Appends the representation of the supplied value to the supplied string and returns the number
+/// of characters appended.
+///
+/// The representations are the same as those written to a pointer, but values of any type which
+/// can be formatted may be appended, including strings. The string grows at most once.
+template <class T>
+size_t format_to(std::string& buffer, const T& value) {
+    auto start = buffer.size();
+    if constexpr (detail::HasFormatSizeV<detail::Formatter<T>>) {
+        buffer.resize(start + FORMAT_SIZE<T>);
+        auto end = format_to(&buffer[start], value);
+        buffer.resize(static_cast<size_t>(end - buffer.data()));
+    } else {
+        StringWriter writer{buffer};
+        detail::format(writer, value);
+    }
+    return buffer.size() - start;
+}
+
+/// Consumes the supplied iterator and appends the consumed items to the supplied buffer, separated
+/// by the supplied separator, and returns the number of bytes appended.
+///
+/// The items are formatted like they are by `format_to`. Strings and bytes are written as is and
+/// references are written as the values they refer to.
+template <class I, Sfinae<std::is_base_of_v<Iterator<typename I::item_t, I>, I>> = 0>
+size_t write_to(I iterator, std::string& buffer, std::string_view separator = {}) {
+    StringWriter writer{buffer};
+    detail::write_items(iterator, writer, separator);
+    return writer.flush();
+}
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_HASH_HPP
+#define VCE_HASH_HPP
+
+#include <vivace/utility.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+namespace vce {
+
+namespace detail {
+    /// The constants mixed into the state of a hasher.
+    static constexpr uint64_t SECRET[] = {
+        0x2d358dccaa6c78a5, 0x8bb84b93962eacc9, 0x4b33a62ed433d4a3, 0x4d5a2da51de1aa47,
+    };
+
+    /// Returns the high and low halves of the product of the two supplied values combined.
+    inline uint64_t mix(uint64_t left, uint64_t right) {
+        __extension__ auto product = static_cast<unsigned __int128>(left) * right;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+    }
+}
+
+/// A streaming hash function.
+///
+/// Integers are combined with the state using a single folded multiplication and byte strings are
+/// hashed with wyhash seeded with the state so that hashes are well distributed even in the low
+/// bits.
+class Hasher {
+    uint64_t state;
+public:
+    /// Constructs a hasher with the default seed.
+    Hasher() : Hasher{0} { }
+
+    /// Constructs a hasher with the supplied seed.
+    explicit Hasher(uint64_t seed) : state{seed} { }
+
+    /// Combines the supplied integer with the state of this hasher.
+    void write(uint64_t value) {
+        state = detail::mix(state ^ detail::SECRET[0], value ^ detail::SECRET[1]);
+    }
+
+    /// Combines the supplied bytes with the state of this hasher.
+    void write(const void* bytes, size_t size);
+
+    /// Returns the hash of the values combined with the state of this hasher.
+    uint64_t finish() const {
+        return detail::mix(state ^ detail::SECRET[2], detail::SECRET[3]);
+    }
+};
+
+/// Combines the supplied unit with the state of the supplied hasher.
+inline void hash_combine(Hasher&, Unit) { }
+
+template <class T, class U>
+void hash_combine(Hasher& hasher, const std::pair<T, U>& pair);
+
+/// Combines the supplied value with the state of the supplied hasher.
+///
+/// Integers, enumerations, floating point numbers, pointers and strings are combined directly and
+/// other values are combined using their `std::hash` specialization.
+template <class T>
+void hash_combine(Hasher& hasher, const T& value) {
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+        hasher.write(static_cast<uint64_t>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        // Positive and negative zero are equal so they must have the same hash.
+        auto normalized = value == 0 ? 0.0 : static_cast<double>(value);
+        uint64_t bits;
+        std::memcpy(&bits, &normalized, sizeof(bits));
+        hasher.write(bits);
+    } else if constexpr (std::is_pointer_v<T>) {
+        hasher.write(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        std::string_view string{value};
+        hasher.write(string.data(), string.size());
+    } else {
+        hasher.write(static_cast<uint64_t>(std::hash<T>{}(value)));
+    }
+}
+
+/// Combines the values in the supplied pair with the state of the supplied hasher.
+template <class T, class U>
+void hash_combine(Hasher& hasher, const std::pair<T, U>& pair) {
+    hash_combine(hasher, pair.first);
+    hash_combine(hasher, pair.second);
+}
+
+/// A hash function object which hashes values with a hasher with the default seed.
+struct Hash {
+    template <class T>
+    size_t operator()(const T& value) const {
+        Hasher hasher;
+        hash_combine(hasher, value);
+        return static_cast<size_t>(hasher.finish());
+    }
+};
+
+}
+
+#endif
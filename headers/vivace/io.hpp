@@ -0,0 +1,369 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_IO_HPP
+#define VCE_IO_HPP
+
+#include <vivace/format.hpp>
+#include <vivace/result.hpp>
+#include <vivace/string.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string_view>
+
+namespace vce {
+
+/// An error which occurred while performing I/O.
+class IoError {
+    int code_;
+
+public:
+    /// Constructs an error with the supplied `errno` value.
+    explicit IoError(int code) : code_{code} { }
+
+    /// Returns an error with the current `errno` value.
+    static IoError last();
+
+    /// Returns the `errno` value of this error.
+    int code() const {
+        return code_;
+    }
+
+    /// Returns a description of this error.
+    const char* message() const;
+
+    friend bool operator==(IoError left, IoError right) {
+        return left.code_ == right.code_;
+    }
+
+    friend bool operator!=(IoError left, IoError right) {
+        return left.code_ != right.code_;
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, IoError error) {
+        return stream << "IoError(" << error.code_ << ": " << error.message() << ")";
+    }
+};
+
+/// A read-only private memory mapping of the contents of a file.
+class MappedFile {
+    const char* data_;
+    size_t size_;
+
+    MappedFile(const char* data, size_t size) : data_{data}, size_{size} { }
+
+public:
+    /// The expected pattern of accesses to a mapping which is passed on to the kernel.
+    enum class Access {
+        /// The mapping is read from start to end so pages are read ahead and dropped behind.
+        Sequential,
+        /// The mapping is read in no particular order so read ahead is disabled.
+        Random,
+    };
+
+    /// Maps the contents of the file at the supplied path into memory.
+    ///
+    /// Large mappings are also hinted to be backed by huge pages where the kernel supports it.
+    static Result<MappedFile, IoError> open(const char* path, Access access = Access::Sequential);
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) : data_{other.data_}, size_{other.size_} {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile& operator=(MappedFile&& other) {
+        if (this != &other) {
+            unmap();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        unmap();
+    }
+
+    /// Returns a pointer to the contents of the file.
+    const char* data() const {
+        return data_;
+    }
+
+    /// Returns the number of bytes in the file.
+    size_t size() const {
+        return size_;
+    }
+
+    /// Returns the contents of the file.
+    std::string_view bytes() const {
+        return {data_, size_};
+    }
+
+private:
+    void unmap();
+};
+
+/// An iterator over the lines in a memory mapped file.
+class MappedLinesIterator : public Iterator<std::string_view, MappedLinesIterator> {
+    MappedFile file;
+    LinesIterator lines;
+
+protected:
+    Bounds bounds_impl() const {
+        return lines.bounds();
+    }
+
+    Option<std::string_view> next_impl() {
+        return lines.next();
+    }
+
+    Option<std::string_view> next_back_impl() {
+        return lines.next_back();
+    }
+
+public:
+    /// Constructs an iterator over the lines in the supplied memory mapped file.
+    MappedLinesIterator(MappedFile file)
+        : file{std::move(file)}, lines{vce::lines(this->file.bytes())} { }
+};
+
+/// An iterator over the fixed-size records in a memory mapped file.
+///
+/// The records are referred to in place and are shared with the iterators split off this iterator.
+template <class T>
+class RecordIterator : public Iterator<Ref<const T>, RecordIterator<T>> {
+    static_assert(std::is_trivially_copyable_v<T>, "records must be trivially copyable");
+
+    std::shared_ptr<const MappedFile> file;
+    const T* begin_;
+    const T* end_;
+
+    RecordIterator(std::shared_ptr<const MappedFile> file, const T* begin, const T* end)
+        : file{std::move(file)}, begin_{begin}, end_{end} { }
+
+protected:
+    Bounds bounds_impl() const {
+        auto size = size_impl();
+        return {size, size};
+    }
+
+    size_t size_impl() const {
+        return static_cast<size_t>(end_ - begin_);
+    }
+
+    Option<Ref<const T>> next_impl() {
+        if (begin_ != end_) {
+            return {std::cref(*begin_++)};
+        } else {
+            return {};
+        }
+    }
+
+    Option<Ref<const T>> next_back_impl() {
+        if (begin_ != end_) {
+            return {std::cref(*--end_)};
+        } else {
+            return {};
+        }
+    }
+
+public:
+    /// Constructs an iterator over the records in the supplied memory mapped file.
+    ///
+    /// Any bytes following the last complete record are ignored.
+    RecordIterator(MappedFile file) : file{std::make_shared<const MappedFile>(std::move(file))} {
+        begin_ = reinterpret_cast<const T*>(this->file->data());
+        end_ = begin_ + this->file->size() / sizeof(T);
+    }
+
+    /// Returns the remaining record at the supplied index, if any.
+    Option<Ref<const T>> get(size_t index) const {
+        if (index < size_impl()) {
+            return {std::cref(begin_[index])};
+        } else {
+            return {};
+        }
+    }
+
+    /// Returns iterators over the remaining records before and after the supplied index.
+    ///
+    /// Panics if the index is greater than the number of remaining records.
+    std::pair<RecordIterator, RecordIterator> split_at(size_t index) const {
+        if (index > size_impl()) {
+            detail::panic("attempted to split records beyond their end");
+        }
+        auto middle = begin_ + index;
+        return {RecordIterator{file, begin_, middle}, RecordIterator{file, middle, end_}};
+    }
+};
+
+/// An iterator over the chunks of bytes read from a file descriptor by a background thread.
+///
+/// Two buffers are allocated up front. The thread fills one while the other is being processed,
+/// and each chunk is valid until the next one is requested.
+class ChunkIterator : public Iterator<Result<Span<const std::byte>, IoError>, ChunkIterator> {
+    using Chunk = Result<Span<const std::byte>, IoError>;
+
+    struct State;
+
+    std::unique_ptr<State> state;
+
+    void stop();
+
+protected:
+    Bounds bounds_impl() const {
+        return {0};
+    }
+
+    Option<Chunk> next_impl();
+
+public:
+    /// Constructs an iterator over the chunks of the supplied size read from the supplied file
+    /// descriptor.
+    ChunkIterator(int fd, size_t chunk_size);
+
+    ChunkIterator(ChunkIterator&& other);
+    ChunkIterator& operator=(ChunkIterator&& other);
+
+    /// Stops the background thread, interrupting it if it is waiting for data.
+    ~ChunkIterator();
+};
+
+/// A buffered writer of the representations of values to a file descriptor.
+///
+/// Values are formatted like they are by `format_to` into a buffer which is written once it is
+/// full. A value too large to fit in the rest of the buffer is written along with the buffer by a
+/// single `writev` instead of being copied. The first error is kept and any values written after it
+/// are discarded.
+class Writer {
+    int fd;
+    std::unique_ptr<char[]> buffer;
+    size_t capacity;
+    size_t size;
+    size_t written;
+    int error;
+
+    void append_slow(const char* data, size_t size);
+
+    /// Writes the buffered bytes followed by the supplied bytes.
+    void write_buffer(const char* data, size_t size);
+
+public:
+    /// The default number of bytes buffered.
+    static constexpr size_t CAPACITY = 64 * 1024;
+
+    /// Constructs a writer to the supplied file descriptor which buffers the supplied number of
+    /// bytes.
+    ///
+    /// The file descriptor is not closed. Panics if the capacity is zero.
+    explicit Writer(int fd, size_t capacity = CAPACITY);
+
+    Writer(const Writer& other) = delete;
+    Writer& operator=(const Writer& other) = delete;
+
+    Writer(Writer&& other) = default;
+    Writer& operator=(Writer&& other) = delete;
+
+    /// Writes the buffered bytes, ignoring any errors.
+    ~Writer();
+
+    /// Returns whether an error has occurred.
+    bool failed() const {
+        return error != 0;
+    }
+
+    /// Buffers the representation of the supplied value.
+    template <class T>
+    void write(const T& value) {
+        detail::format(*this, value);
+    }
+
+    /// Buffers the supplied bytes.
+    void append(const char* data, size_t size) {
+        if (VCE_LIKELY(size <= capacity - this->size)) {
+            // Empty strings may not have any storage.
+            if (size != 0) {
+                std::memcpy(buffer.get() + this->size, data, size);
+                this->size += size;
+            }
+        } else {
+            append_slow(data, size);
+        }
+    }
+
+    /// Writes the buffered bytes and returns the total number of bytes written or the first error.
+    ///
+    /// Short writes are continued until every byte is written and interrupted writes are retried.
+    Result<size_t, IoError> flush();
+};
+
+/// Consumes the supplied iterator and writes the consumed items to the supplied file descriptor,
+/// separated by the supplied separator, and returns the number of bytes written.
+///
+/// The items are formatted like they are by `format_to` into a large buffer which is flushed with
+/// `writev` so only a few system calls are made. Strings and bytes are written as is and references
+/// are written as the values they refer to. The iterator is only consumed until the first error
+/// which is returned instead of the number of bytes written.
+template <class I, Sfinae<std::is_base_of_v<Iterator<typename I::item_t, I>, I>> = 0>
+Result<size_t, IoError> write_to(I iterator, int fd, std::string_view separator = {}) {
+    Writer writer{fd};
+    detail::write_items(iterator, writer, separator);
+    return writer.flush();
+}
+
+/// Returns an iterator over the chunks of the supplied size read from the supplied file
+/// descriptor.
+///
+/// Reading continues in the background while each chunk is processed. Each chunk holds the bytes
+/// returned by a single read so chunks read from pipes and sockets may be partial, but they are
+/// emitted as soon as any data is available. An error is emitted in place of the next chunk after
+/// which the iterator ends. The file descriptor is not closed. Panics if the chunk size is zero.
+inline ChunkIterator read_chunks(int fd, size_t chunk_size) {
+    return {fd, chunk_size};
+}
+
+/// Returns an iterator over the lines in the file at the supplied path.
+///
+/// The file is mapped into memory and the lines are views of the mapping which remain valid as
+/// long as the iterator does.
+Result<MappedLinesIterator, IoError> mmap_lines(const char* path);
+
+/// Returns an iterator over the fixed-size records in the file at the supplied path.
+///
+/// The file is mapped into memory and the records are references into the mapping which remain
+/// valid as long as the iterator or any iterator split off it does. A file whose size is not a
+/// multiple of the record size fails with `EINVAL`.
+template <class T>
+Result<RecordIterator<T>, IoError> mmap_records(const char* path) {
+    return MappedFile::open(path).and_then([](auto file) -> Result<RecordIterator<T>, IoError> {
+        if (file.size() % sizeof(T) != 0) {
+            return {ERR, IoError{EINVAL}};
+        }
+        return {OK, RecordIterator<T>{std::move(file)}};
+    });
+}
+
+}
+
+#endif
@@ -15,10 +15,15 @@
 #ifndef VCE_ITERATOR_HPP
 #define VCE_ITERATOR_HPP
 
+#include <vivace/arena.hpp>
 #include <vivace/math.hpp>
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace vce {
 
@@ -42,15 +47,26 @@ bool operator!=(Bounds left, Bounds right);
 
 std::ostream& operator<<(std::ostream& stream, Bounds bounds);
 
+void hash_combine(Hasher& hasher, Bounds bounds);
+
 template <class T, class I>
 class Iterator;
 
+template <class T, class I>
+class ContainerIterator;
+
 namespace detail {
+    template <class T, class I>
+    class ParseAll;
+
     template <class T, class I>
     class IteratorRef : public Iterator<T, IteratorRef<T, I>> {
         Ref<I> source;
 
     protected:
+        /// Whether the exact size of this iterator is known.
+        static constexpr bool SIZED = I::HAS_SIZE;
+
         Bounds bounds_impl() const {
             return source.get().bounds();
         }
@@ -92,7 +108,7 @@ namespace detail {
             if constexpr (I::HAS_SIZE) {
                 collection.reserve(iterator.size());
             } else {
-                collection.reserve(iterator.bounds.lower);
+                collection.reserve(iterator.bounds().lower);
             }
         }
     }
@@ -105,6 +121,239 @@ namespace detail {
             collection.insert(std::move(value));
         }
     }
+
+    template <class C>
+    struct TryTraits {
+        static constexpr bool value = false;
+    };
+
+    template <class T, class E>
+    struct TryTraits<Result<T, E>> {
+        static constexpr bool value = true;
+
+        using value_t = T;
+
+        static Result<T, E> wrap(T value) {
+            return {OK, std::move(value)};
+        }
+    };
+
+    template <class T>
+    struct TryTraits<Option<T>> {
+        static constexpr bool value = true;
+
+        using value_t = T;
+
+        static Option<T> wrap(T value) {
+            return {std::move(value)};
+        }
+    };
+
+    template <class I>
+    struct BytewiseTraits {
+        static constexpr bool value = false;
+    };
+
+    template <class T, class V>
+    struct BytewiseTraits<ContainerIterator<T, V*>> {
+        static constexpr bool value =
+            std::is_integral_v<V> || std::is_enum_v<V> || std::is_pointer_v<V>;
+
+        using value_t = std::remove_cv_t<V>;
+    };
+
+    /// Whether the items in the two supplied iterators are contiguous and equal exactly when their
+    /// bytes are equal.
+    template <class L, class R>
+    static constexpr bool IsBytewiseV = [] {
+        if constexpr (BytewiseTraits<L>::value && BytewiseTraits<R>::value) {
+            using LV = typename BytewiseTraits<L>::value_t;
+            return std::is_same_v<LV, typename BytewiseTraits<R>::value_t>;
+        } else {
+            return false;
+        }
+    }();
+
+    /// Returns the offset of the first byte which differs in the two supplied byte strings or the
+    /// supplied size if there is no such byte.
+    size_t mismatch(const void* left, const void* right, size_t size);
+
+    /// Whether the items in the supplied iterator are contiguous integers.
+    template <class I>
+    static constexpr bool IsContiguousIntegerV = [] {
+        if constexpr (BytewiseTraits<I>::value) {
+            using V = typename BytewiseTraits<I>::value_t;
+            return std::is_integral_v<V> && !std::is_same_v<V, bool>;
+        } else {
+            return false;
+        }
+    }();
+
+    /// Returns the position of the first of the supplied integers which is equal to the supplied
+    /// integer or the supplied size if there is no such integer.
+    template <class V>
+    size_t find(const V* data, size_t size, V value) {
+        if constexpr (sizeof(V) == 1) {
+            if (size == 0) {
+                return 0;
+            }
+            auto found = std::memchr(data, static_cast<unsigned char>(value), size);
+            return found ? static_cast<const V*>(found) - data : size;
+        } else {
+            using S = Simd<V>;
+            using W = typename S::type;
+
+            // Matches are checked for once per group of vectors and the group with the first match
+            // is searched again one integer at a time.
+            auto needle = S::splat(value);
+            size_t i = 0;
+            for (; i + 4 * S::LANES <= size; i += 4 * S::LANES) {
+                auto any = (W)(S::load(data + i) == needle) |
+                           (W)(S::load(data + i + S::LANES) == needle) |
+                           (W)(S::load(data + i + 2 * S::LANES) == needle) |
+                           (W)(S::load(data + i + 3 * S::LANES) == needle);
+                if (S::any_high(any)) {
+                    break;
+                }
+            }
+
+            for (; i < size; ++i) {
+                if (data[i] == value) {
+                    return i;
+                }
+            }
+            return size;
+        }
+    }
+
+    /// Returns the position of the first occurrence of the supplied needle in the supplied
+    /// integers or the supplied size if there is no such occurrence.
+    template <class V>
+    size_t search(const V* data, size_t size, const V* needle, size_t length) {
+        if (length == 0) {
+            return 0;
+        } else if (length > size) {
+            return size;
+        }
+
+        if constexpr (sizeof(V) == 1) {
+            auto found = ::memmem(data, size, needle, length);
+            return found ? static_cast<const V*>(found) - data : size;
+        } else {
+            size_t i = 0;
+            while (i <= size - length) {
+                i += find(data + i, size - length + 1 - i, needle[0]);
+                if (i <= size - length && std::memcmp(data + i, needle, length * sizeof(V)) == 0) {
+                    return i;
+                }
+                i += 1;
+            }
+            return size;
+        }
+    }
+
+    /// Whether the supplied container is contiguous and contains the same type of items as the
+    /// supplied contiguous iterator.
+    template <class C, class I>
+    static constexpr bool IsSameContiguousV = [] {
+        using V = typename C::value_type;
+        if constexpr (BytewiseTraits<I>::value && IsSpanConstructibleV<const V, const C>) {
+            return std::is_same_v<typename BytewiseTraits<I>::value_t, V>;
+        } else {
+            return false;
+        }
+    }();
+
+    /// Returns whether the supplied value can be represented by the supplied integer type.
+    template <class V, class U>
+    bool representable(U value) {
+        auto converted = static_cast<V>(value);
+        return static_cast<U>(converted) == value && (converted < V{}) == (value < U{});
+    }
+
+    /// Returns the minimum and maximum of the supplied non-empty sequence of integers.
+    template <class V>
+    std::pair<V, V> minmax_values(const V* data, size_t size) {
+        using S = Simd<V>;
+
+        auto min = data[0];
+        auto max = data[0];
+
+        size_t i = 0;
+        if (size >= 2 * S::LANES) {
+            // Two pairs of accumulators are used to hide the latency of the comparisons.
+            auto vmin = S::load(data);
+            auto vmax = vmin;
+            auto wmin = S::load(data + S::LANES);
+            auto wmax = wmin;
+            for (i = 2 * S::LANES; i + 2 * S::LANES <= size; i += 2 * S::LANES) {
+                auto v = S::load(data + i);
+                auto w = S::load(data + i + S::LANES);
+                vmin = v < vmin ? v : vmin;
+                vmax = v > vmax ? v : vmax;
+                wmin = w < wmin ? w : wmin;
+                wmax = w > wmax ? w : wmax;
+            }
+            vmin = wmin < vmin ? wmin : vmin;
+            vmax = wmax > vmax ? wmax : vmax;
+            for (size_t lane = 0; lane < S::LANES; ++lane) {
+                min = std::min<V>(min, vmin[lane]);
+                max = std::max<V>(max, vmax[lane]);
+            }
+        }
+
+        for (; i < size; ++i) {
+            min = std::min(min, data[i]);
+            max = std::max(max, data[i]);
+        }
+
+        return {min, max};
+    }
+
+    /// Returns the first minimum and last maximum of the supplied non-empty sequence of integers.
+    ///
+    /// The sequence is reduced in blocks and the blocks in which the minimum and maximum were last
+    /// improved are remembered so only those two blocks are searched for the items.
+    template <class V>
+    std::pair<const V*, const V*> minmax(const V* data, size_t size) {
+        constexpr size_t BLOCK = 1024;
+
+        auto [min, max] = minmax_values(data, std::min(size, BLOCK));
+        size_t min_block = 0;
+        size_t max_block = 0;
+        for (size_t i = BLOCK; i < size; i += BLOCK) {
+            auto [block_min, block_max] = minmax_values(data + i, std::min(size - i, BLOCK));
+            if (block_min < min) {
+                min = block_min;
+                min_block = i;
+            }
+            if (block_max >= max) {
+                max = block_max;
+                max_block = i;
+            }
+        }
+
+        auto first = std::find(data + min_block, data + std::min(size, min_block + BLOCK), min);
+        auto last = data + std::min(size, max_block + BLOCK) - 1;
+        while (*last != max) {
+            --last;
+        }
+        return {first, last};
+    }
+
+    /// Returns the supplied value.
+    template <class T>
+    const T& unref(const T& value) {
+        return value;
+    }
+
+    /// Returns the value referred to by the supplied reference.
+    template <class T>
+    T& unref(const std::reference_wrapper<T>& reference) {
+        return reference.get();
+    }
+
+    #include <vivace/iterator/sort.hpp>
 }
 
 /// An iterator.
@@ -126,6 +375,16 @@ class Iterator {
             return false;
         }
 
+        template <class C, class U>
+        constexpr static auto is_sized(int) -> decltype(C::SIZED, true) {
+            return C::SIZED;
+        }
+
+        template <class C, class U>
+        constexpr static auto is_sized(bool) -> bool {
+            return true;
+        }
+
         template <class C, class U>
         constexpr static auto has_next_back(int) -> VCE_HAS(C, U, next_back_impl) {
             return true;
@@ -188,7 +447,10 @@ public:
     using item_t = T;
 
     /// Whether this iterator knows its exact size.
-    static constexpr bool HAS_SIZE = Crtp::template has_size<Crtp, I>(0);
+    ///
+    /// Adaptors define `SIZED` to report whether the iterators they adapt know their exact sizes.
+    static constexpr bool HAS_SIZE =
+        Crtp::template has_size<Crtp, I>(0) && Crtp::template is_sized<Crtp, I>(0);
     /// Whether this iterator supports emitting items from the back.
     static constexpr bool HAS_NEXT_BACK = Crtp::template has_next_back<Crtp, I>(0);
 
@@ -260,6 +522,16 @@ public:
         return {static_cast<I&&>(*this), std::move(f)};
     }
 
+    /// Returns an iterator that parses the strings emitted by this iterator as numbers of the
+    /// supplied type with `parse`.
+    ///
+    /// The iterator ends after emitting the error for the first string which can't be parsed so
+    /// collecting it into a result stops at that string. Requires `vivace/parse.hpp`.
+    template <class U, class P = detail::ParseAll<U, I>>
+    P parse_all() {
+        return {static_cast<I&&>(*this)};
+    }
+
     /// Returns an iterator that emits the items in this iterator in reverse.
     detail::Reverse<T, I> reverse() {
         return {static_cast<I&&>(*this)};
@@ -322,14 +594,30 @@ public:
     }
 
     /// Consumes this iterator and returns the consumed items in a container.
+    ///
+    /// If this iterator emits results (or options) and the container is wrapped in a result (or
+    /// option), this iterator is only consumed until the first error (or empty option) which is
+    /// returned instead of the container.
     template <class C = std::vector<T>>
     C collect() {
-        C collection;
-        detail::reserve(*this, collection);
-        for (auto item : *this) {
-            detail::add(collection, std::move(item));
+        if constexpr (detail::TryTraits<C>::value && detail::TryTraits<T>::value) {
+            typename detail::TryTraits<C>::value_t collection;
+            detail::reserve(*this, collection);
+            for (auto item : *this) {
+                if (VCE_UNLIKELY(detail::Try::failed(item))) {
+                    return detail::Try::residual(item);
+                }
+                detail::add(collection, detail::Try::value(item));
+            }
+            return detail::TryTraits<C>::wrap(std::move(collection));
+        } else {
+            C collection;
+            detail::reserve(*this, collection);
+            for (auto item : *this) {
+                detail::add(collection, std::move(item));
+            }
+            return collection;
         }
-        return collection;
     }
 
     /// Consumes this iterator and returns the consumed items partitioned into two containers by the
@@ -347,6 +635,61 @@ public:
         return collections;
     }
 
+    /// Consumes this iterator and returns the consumed items in a container which allocates its
+    /// memory from the supplied arena.
+    template <class C = std::vector<T, ArenaAllocator<T>>>
+    C collect_in(Arena& arena) {
+        C collection{typename C::allocator_type{arena}};
+        detail::reserve(*this, collection);
+        for (auto item : *this) {
+            detail::add(collection, std::move(item));
+        }
+        return collection;
+    }
+
+    /// Consumes this iterator and returns the consumed items partitioned by the supplied predicate
+    /// into two containers which allocate their memory from the supplied arena.
+    template <class C = std::vector<T, ArenaAllocator<T>>, class F>
+    std::pair<C, C> partition_in(Arena& arena, F f) {
+        typename C::allocator_type allocator{arena};
+        std::pair<C, C> collections{C{allocator}, C{allocator}};
+        for (auto item : *this) {
+            if (std::invoke(f, item)) {
+                detail::add(collections.first, std::move(item));
+            } else {
+                detail::add(collections.second, std::move(item));
+            }
+        }
+        return collections;
+    }
+
+    /// Consumes this iterator and returns the consumed items sorted stably in a vector.
+    ///
+    /// Integers and floating point numbers are sorted with a radix sort.
+    std::vector<T> sorted() {
+        return detail::sort(collect<std::vector<T>>());
+    }
+
+    /// Consumes this iterator and returns the consumed items sorted stably in a vector by the keys
+    /// returned by the supplied function.
+    ///
+    /// The supplied function is called once for each item and integer and floating point keys are
+    /// sorted with a radix sort.
+    template <class F>
+    std::vector<T> sorted_by_key(F f) {
+        return detail::sort_by_key<true>(collect<std::vector<T>>(), std::move(f));
+    }
+
+    /// Consumes this iterator and returns the consumed items sorted in a vector by the keys
+    /// returned by the supplied function without preserving the order of items with equal keys.
+    ///
+    /// The supplied function is called once for each item and integer and floating point keys are
+    /// sorted with a radix sort.
+    template <class F>
+    std::vector<T> sorted_unstable_by_key(F f) {
+        return detail::sort_by_key<false>(collect<std::vector<T>>(), std::move(f));
+    }
+
     /// Consumes this iterator and returns the value accumulated by the supplied function.
     template <class U, class F>
     U fold(U seed, F f) {
@@ -366,6 +709,12 @@ public:
         return fold(static_cast<T>(1), [](auto a, auto i) { return a * i; });
     }
 
+    /// Consumes this iterator and returns the sum of the consumed items where each addition
+    /// saturates at the numeric bounds instead of overflowing.
+    T saturating_sum() {
+        return fold(static_cast<T>(0), [](auto a, auto i) { return saturating_add(a, i); });
+    }
+
     /// Consumes this iterator until it can return whether all of the consumed items satisfy the
     /// supplied predicate.
     template <class F>
@@ -416,6 +765,68 @@ public:
         return {};
     }
 
+    /// Consumes this iterator until the position of the first consumed item which is equal to the
+    /// supplied value can be returned, if any.
+    template <class U>
+    Option<size_t> position_eq(const U& value) {
+        if constexpr (detail::IsContiguousIntegerV<I> && std::is_integral_v<U>) {
+            return contiguous_position(value);
+        } else {
+            return position([&](const auto& item) { return detail::unref(item) == value; });
+        }
+    }
+
+    /// Consumes this iterator until the first consumed item which is equal to the supplied value
+    /// can be returned, if any.
+    template <class U>
+    Option<T> find_eq(const U& value) {
+        if constexpr (detail::IsContiguousIntegerV<I> && std::is_integral_v<U>) {
+            if (contiguous_position(value).is_some()) {
+                return {*(static_cast<I&>(*this).begin_ - 1)};
+            } else {
+                return {};
+            }
+        } else {
+            return find([&](const auto& item) { return detail::unref(item) == value; });
+        }
+    }
+
+    /// Consumes this iterator until it can return whether any of the consumed items are equal to
+    /// the supplied value.
+    template <class U>
+    bool contains(const U& value) {
+        return position_eq(value).is_some();
+    }
+
+    /// Consumes this iterator and returns the position of the first occurrence of the items in the
+    /// supplied container as a contiguous sequence of items in this iterator, if any.
+    template <class C>
+    Option<size_t> position_subsequence(const C& needle) {
+        using V = typename C::value_type;
+        if constexpr (detail::IsContiguousIntegerV<I> && detail::IsSameContiguousV<C, I>) {
+            auto& self = static_cast<I&>(*this);
+            auto size = static_cast<size_t>(self.end_ - self.begin_);
+            auto position = detail::search(self.begin_, size, needle.data(), needle.size());
+            self.begin_ = self.end_;
+            if (position != size || needle.size() == 0) {
+                return {position};
+            } else {
+                return {};
+            }
+        } else {
+            auto haystack = collect<std::vector<T>>();
+            auto begin = haystack.begin();
+            auto end = haystack.end();
+            auto equal = [](const T& item, const V& value) { return detail::unref(item) == value; };
+            auto found = std::search(begin, end, needle.begin(), needle.end(), equal);
+            if (found != end || needle.begin() == needle.end()) {
+                return {static_cast<size_t>(found - begin)};
+            } else {
+                return {};
+            }
+        }
+    }
+
     /// Consumes this iterator and returns the first minimal item consumed.
     Option<T> min() {
         return select(std::less{}, [](const auto& i) { return i; });
@@ -440,21 +851,262 @@ public:
         return select(std::greater_equal{}, f);
     }
 
+    /// Consumes this iterator and the supplied iterator until the lexicographic ordering of their
+    /// items can be returned.
+    template <class R>
+    Ordering cmp(R iterator) {
+        if constexpr (detail::IsBytewiseV<I, R>) {
+            return bytewise_cmp(iterator);
+        } else {
+            while (true) {
+                auto left = next();
+                auto right = iterator.next();
+                if (left.is_none() || right.is_none()) {
+                    return vce::compare(left.is_some(), right.is_some());
+                }
+                auto lvalue = left.unwrap();
+                auto rvalue = right.unwrap();
+                auto&& litem = detail::unref(lvalue);
+                auto&& ritem = detail::unref(rvalue);
+                auto ordering = vce::compare(litem, ritem);
+                if (ordering != Ordering::Equal) {
+                    return ordering;
+                }
+            }
+        }
+    }
+
+    /// Consumes this iterator and the supplied iterator until the lexicographic ordering of their
+    /// items can be returned, if the first pair of items which are not equal are ordered.
+    template <class R>
+    Option<Ordering> partial_cmp(R iterator) {
+        if constexpr (detail::IsBytewiseV<I, R>) {
+            return {bytewise_cmp(iterator)};
+        } else {
+            while (true) {
+                auto left = next();
+                auto right = iterator.next();
+                if (left.is_none() || right.is_none()) {
+                    return {vce::compare(left.is_some(), right.is_some())};
+                }
+                auto lvalue = left.unwrap();
+                auto rvalue = right.unwrap();
+                auto&& litem = detail::unref(lvalue);
+                auto&& ritem = detail::unref(rvalue);
+                if (litem < ritem) {
+                    return {Ordering::Less};
+                } else if (ritem < litem) {
+                    return {Ordering::Greater};
+                } else if (!(litem == ritem)) {
+                    return {};
+                }
+            }
+        }
+    }
+
+    /// Consumes this iterator and the supplied iterator until it can return whether their items
+    /// are equal.
+    template <class R>
+    bool eq(R iterator) {
+        if constexpr (detail::IsBytewiseV<I, R>) {
+            return bytewise_cmp(iterator) == Ordering::Equal;
+        } else {
+            while (true) {
+                auto left = next();
+                auto right = iterator.next();
+                if (left.is_none() || right.is_none()) {
+                    return left.is_none() && right.is_none();
+                }
+                auto lvalue = left.unwrap();
+                auto rvalue = right.unwrap();
+                auto&& litem = detail::unref(lvalue);
+                auto&& ritem = detail::unref(rvalue);
+                if (!(litem == ritem)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    /// Consumes this iterator and the supplied iterator until it can return whether their items
+    /// are not equal.
+    template <class R>
+    bool ne(R iterator) {
+        return !eq(std::move(iterator));
+    }
+
+    /// Consumes this iterator and the supplied iterator until it can return whether the items in
+    /// this iterator are lexicographically less than the items in the supplied iterator.
+    template <class R>
+    bool lt(R iterator) {
+        return partial_cmp(std::move(iterator)) == Option<Ordering>{Ordering::Less};
+    }
+
+    /// Consumes this iterator and the supplied iterator until it can return whether the items in
+    /// this iterator are lexicographically less than or equal to the items in the supplied
+    /// iterator.
+    template <class R>
+    bool le(R iterator) {
+        auto ordering = partial_cmp(std::move(iterator));
+        return ordering.is_some() && ordering != Option<Ordering>{Ordering::Greater};
+    }
+
+    /// Consumes this iterator and the supplied iterator until it can return whether the items in
+    /// this iterator are lexicographically greater than the items in the supplied iterator.
+    template <class R>
+    bool gt(R iterator) {
+        return partial_cmp(std::move(iterator)) == Option<Ordering>{Ordering::Greater};
+    }
+
+    /// Consumes this iterator and the supplied iterator until it can return whether the items in
+    /// this iterator are lexicographically greater than or equal to the items in the supplied
+    /// iterator.
+    template <class R>
+    bool ge(R iterator) {
+        auto ordering = partial_cmp(std::move(iterator));
+        return ordering.is_some() && ordering != Option<Ordering>{Ordering::Less};
+    }
+
+    /// Consumes this iterator and returns the first minimal and last maximal items consumed.
+    ///
+    /// The items are compared in pairs so about one and a half comparisons are made per item.
+    Option<std::pair<T, T>> minmax() {
+        if constexpr (detail::IsContiguousIntegerV<I>) {
+            auto& self = static_cast<I&>(*this);
+            auto begin = self.begin_;
+            auto end = self.end_;
+            self.begin_ = end;
+            if (begin == end) {
+                return {};
+            }
+
+            auto [first, last] = detail::minmax(begin, end - begin);
+            return {std::pair<T, T>{*first, *last}};
+        } else {
+            return select_minmax([](T item) { return item; }, [](const T& item) -> decltype(auto) {
+                return detail::unref(item);
+            });
+        }
+    }
+
+    /// Consumes this iterator and returns the first minimal and last maximal items consumed as
+    /// ordered by the keys returned by the supplied function.
+    ///
+    /// The supplied function is called once for each item and the items are compared in pairs so
+    /// about one and a half comparisons are made per item.
+    template <class F>
+    Option<std::pair<T, T>> minmax_by_key(F f) {
+        auto entry = [&](T item) {
+            auto key = std::invoke(f, item);
+            return std::pair<T, decltype(key)>{std::move(item), std::move(key)};
+        };
+        auto key = [](const auto& entry) -> decltype(auto) { return detail::unref(entry.second); };
+        return select_minmax(entry, key).map([](auto entries) {
+            return std::pair<T, T>{std::move(entries.first.first), std::move(entries.second.first)};
+        });
+    }
+
 private:
+    template <class U>
+    Option<size_t> contiguous_position(const U& value) {
+        using V = typename detail::BytewiseTraits<I>::value_t;
+        auto& self = static_cast<I&>(*this);
+        auto size = static_cast<size_t>(self.end_ - self.begin_);
+        if (!detail::representable<V>(value)) {
+            self.begin_ = self.end_;
+            return {};
+        }
+
+        auto position = detail::find<V>(self.begin_, size, static_cast<V>(value));
+        self.begin_ += std::min(position + 1, size);
+        if (position != size) {
+            return {position};
+        } else {
+            return {};
+        }
+    }
+
+    template <class E, class K>
+    auto select_minmax(E entry, K key) -> Option<std::pair<decltype(entry(std::declval<T>())),
+                                                             decltype(entry(std::declval<T>()))>> {
+        auto first = next();
+        if (first.is_none()) {
+            return {};
+        }
+
+        auto min = entry(first.unwrap());
+        auto max = min;
+        while (true) {
+            auto left = next();
+            if (left.is_none()) {
+                break;
+            }
+
+            auto right = next();
+            if (right.is_none()) {
+                auto last = entry(left.unwrap());
+                if (key(last) < key(min)) {
+                    min = std::move(last);
+                } else if (key(last) >= key(max)) {
+                    max = std::move(last);
+                }
+                break;
+            }
+
+            // Ties leave the earlier entry as the smaller entry and the later entry as the larger
+            // entry so the first minimal and last maximal entries are selected.
+            auto small = entry(left.unwrap());
+            auto large = entry(right.unwrap());
+            if (key(large) < key(small)) {
+                std::swap(small, large);
+            }
+            if (key(small) < key(min)) {
+                min = std::move(small);
+            }
+            if (key(large) >= key(max)) {
+                max = std::move(large);
+            }
+        }
+
+        return {std::pair<decltype(min), decltype(max)>{std::move(min), std::move(max)}};
+    }
+
+    template <class R>
+    Ordering bytewise_cmp(R& iterator) {
+        auto& self = static_cast<I&>(*this);
+        auto left = self.begin_;
+        auto right = iterator.begin_;
+        auto lsize = self.size();
+        auto rsize = iterator.size();
+        auto size = std::min(lsize, rsize);
+
+        auto index = detail::mismatch(left, right, size * sizeof(*left)) / sizeof(*left);
+        // Consume the same items as would be consumed when comparing the items one at a time.
+        self.begin_ += std::min(index + 1, lsize);
+        if (index < size) {
+            return vce::compare(left[index], right[index]);
+        } else {
+            return vce::compare(lsize, rsize);
+        }
+    }
+
     template <class C, class F>
     Option<T> select(C comparator, F f) {
-        auto selection = next();
-        if (selection.is_some()) {
-            auto&& skey = std::invoke(f, selection.as_ref().unwrap().get());
-            for (auto item : *this) {
-                auto&& ikey = std::invoke(f, item);
-                if (comparator(ikey, skey)) {
-                    selection = std::move(item);
-                    skey = std::move(ikey);
-                }
+        auto first = next();
+        if (first.is_none()) {
+            return {};
+        }
+
+        auto selection = first.unwrap();
+        auto skey = std::invoke(f, selection);
+        for (auto item : *this) {
+            auto ikey = std::invoke(f, item);
+            if (comparator(detail::unref(ikey), detail::unref(skey))) {
+                selection = std::move(item);
+                skey = std::move(ikey);
             }
         }
-        return selection;
+        return {std::move(selection)};
     }
 };
 
@@ -466,10 +1118,16 @@ class ContainerIterator : public Iterator<T, ContainerIterator<T, I>> {
     static constexpr bool BIDIRECTIONAL = std::is_same_v<Tag, std::bidirectional_iterator_tag>;
     static constexpr bool RANDOM_ACCESS = std::is_same_v<Tag, std::random_access_iterator_tag>;
 
+    template <class, class>
+    friend class Iterator;
+
     I begin_;
     I end_;
 
 protected:
+    /// Whether the exact size of this iterator is known.
+    static constexpr bool SIZED = RANDOM_ACCESS;
+
     Bounds bounds_impl() const {
         if constexpr (RANDOM_ACCESS) {
             auto size = size_impl();
@@ -507,10 +1165,17 @@ public:
 };
 
 /// Returns an iterator over the items in the supplied container.
+///
+/// The items in contiguous containers are iterated over with pointers.
 template <class C>
-ContainerIterator<Ref<const typename C::value_type>, typename C::const_iterator>
-container(const C& container) {
-    return {container.begin(), container.end()};
+auto container(const C& container) {
+    using T = Ref<const typename C::value_type>;
+    if constexpr (detail::IsSpanConstructibleV<const typename C::value_type, const C>) {
+        auto data = container.data();
+        return ContainerIterator<T, decltype(data)>{data, data + container.size()};
+    } else {
+        return ContainerIterator<T, typename C::const_iterator>{container.begin(), container.end()};
+    }
 }
 
 /// Returns an iterator over the items in the supplied container.
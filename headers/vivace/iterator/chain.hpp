@@ -21,6 +21,9 @@ class Chain : public Iterator<T, Chain<T, L, R>> {
     State state;
 
 protected:
+    /// Whether the exact size of this iterator is known.
+    static constexpr bool SIZED = L::HAS_SIZE && R::HAS_SIZE;
+
     Bounds bounds_impl() const {
         auto lbounds = left.bounds();
         auto rbounds = right.bounds();
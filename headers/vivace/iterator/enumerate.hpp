@@ -23,6 +23,9 @@ class Enumerate : public Iterator<T, Enumerate<T, I>> {
     }
 
 protected:
+    /// Whether the exact size of this iterator is known.
+    static constexpr bool SIZED = I::HAS_SIZE;
+
     Bounds bounds_impl() const {
         return source.bounds();
     }
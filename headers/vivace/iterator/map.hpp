@@ -18,6 +18,9 @@ class Map : public Iterator<T, Map<T, I, F>> {
     F f;
 
 protected:
+    /// Whether the exact size of this iterator is known.
+    static constexpr bool SIZED = I::HAS_SIZE;
+
     Bounds bounds_impl() const {
         return source.bounds();
     }
@@ -17,6 +17,9 @@ class Reverse : public Iterator<T, Reverse<T, I>> {
     I source;
 
 protected:
+    /// Whether the exact size of this iterator is known.
+    static constexpr bool SIZED = I::HAS_SIZE;
+
     Bounds bounds_impl() const {
         return source.bounds();
     }
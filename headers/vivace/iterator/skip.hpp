@@ -18,6 +18,9 @@ class Skip : public Iterator<T, Skip<T, I>> {
     size_t n;
 
 protected:
+    /// Whether the exact size of this iterator is known.
+    static constexpr bool SIZED = I::HAS_SIZE;
+
     Bounds bounds_impl() const {
         auto bounds = source.bounds();
         auto lower = saturating_sub(bounds.lower, n);
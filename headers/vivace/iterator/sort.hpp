@@ -0,0 +1,149 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// The number of items below which items are sorted by comparison instead of with a radix sort.
+static constexpr size_t RADIX_THRESHOLD = 256;
+
+/// Whether keys of the supplied type are sorted with a radix sort.
+template <class K>
+static constexpr bool IsRadixKeyV =
+    (std::is_integral_v<K> && !std::is_same_v<K, bool>) ||
+    std::is_same_v<K, float> ||
+    std::is_same_v<K, double>;
+
+/// Returns the unsigned integer which is ordered relative to the other unsigned integers returned
+/// by this function as the supplied key is ordered relative to other keys.
+template <class K>
+auto radix_key(K key) {
+    if constexpr (std::is_floating_point_v<K>) {
+        using U = std::conditional_t<sizeof(K) == sizeof(uint32_t), uint32_t, uint64_t>;
+        // Negative and positive zero are equal so they must have the same key.
+        K normalized = key == 0 ? K{0} : key;
+        U bits;
+        std::memcpy(&bits, &normalized, sizeof(bits));
+        // The bits of negative numbers are inverted so they sort in reverse and below the positive
+        // numbers which only have their sign bit set.
+        static constexpr U SIGN = U{1} << (8 * sizeof(U) - 1);
+        return static_cast<U>(bits ^ ((U{0} - (bits >> (8 * sizeof(U) - 1))) | SIGN));
+    } else if constexpr (std::is_signed_v<K>) {
+        using U = std::make_unsigned_t<K>;
+        return static_cast<U>(static_cast<U>(key) ^ (U{1} << (8 * sizeof(U) - 1)));
+    } else {
+        return key;
+    }
+}
+
+/// Sorts the supplied entries stably by their keys with a least significant digit radix sort.
+template <class U>
+void radix_sort(std::vector<std::pair<U, size_t>>& entries) {
+    static constexpr size_t DIGITS = sizeof(U);
+
+    // The digit counts for every pass are gathered up front in a single pass over the entries.
+    size_t counts[DIGITS][256] = {};
+    for (const auto& entry : entries) {
+        for (size_t digit = 0; digit < DIGITS; ++digit) {
+            counts[digit][(entry.first >> (8 * digit)) & 0xFF] += 1;
+        }
+    }
+
+    std::vector<std::pair<U, size_t>> buffer(entries.size());
+    for (size_t digit = 0; digit < DIGITS; ++digit) {
+        auto& count = counts[digit];
+
+        // A pass is skipped if every entry has the same value for the digit.
+        if (count[(entries[0].first >> (8 * digit)) & 0xFF] == entries.size()) {
+            continue;
+        }
+
+        size_t offsets[256];
+        size_t offset = 0;
+        for (size_t value = 0; value < 256; ++value) {
+            offsets[value] = offset;
+            offset += count[value];
+        }
+
+        for (const auto& entry : entries) {
+            buffer[offsets[(entry.first >> (8 * digit)) & 0xFF]++] = entry;
+        }
+        entries.swap(buffer);
+    }
+}
+
+/// Returns the supplied items in the order of the supplied entries.
+template <class T, class E>
+std::vector<T> gather(std::vector<T>& items, const std::vector<E>& entries) {
+    std::vector<T> sorted;
+    sorted.reserve(items.size());
+    for (const auto& entry : entries) {
+        sorted.push_back(std::move(items[entry.second]));
+    }
+    return sorted;
+}
+
+/// Returns the supplied items sorted by the keys returned by the supplied function.
+///
+/// The keys are computed once for each item.
+template <bool STABLE, class T, class F>
+std::vector<T> sort_by_key(std::vector<T> items, F f) {
+    using K = std::decay_t<std::invoke_result_t<F&, T&>>;
+
+    if constexpr (IsRadixKeyV<K>) {
+        using U = decltype(radix_key(std::declval<K>()));
+        std::vector<std::pair<U, size_t>> entries;
+        entries.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            entries.emplace_back(radix_key<K>(std::invoke(f, items[i])), i);
+        }
+
+        if (entries.size() >= RADIX_THRESHOLD) {
+            radix_sort(entries);
+        } else {
+            auto less = [](const auto& l, const auto& r) { return l.first < r.first; };
+            std::stable_sort(entries.begin(), entries.end(), less);
+        }
+        return gather(items, entries);
+    } else {
+        std::vector<std::pair<K, size_t>> entries;
+        entries.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            entries.emplace_back(std::invoke(f, items[i]), i);
+        }
+
+        auto less = [](const auto& l, const auto& r) {
+            return vce::compare(unref(l.first), unref(r.first)) == Ordering::Less;
+        };
+        if constexpr (STABLE) {
+            std::stable_sort(entries.begin(), entries.end(), less);
+        } else {
+            std::sort(entries.begin(), entries.end(), less);
+        }
+        return gather(items, entries);
+    }
+}
+
+/// Returns the supplied items sorted stably.
+template <class T>
+std::vector<T> sort(std::vector<T> items) {
+    using V = std::decay_t<decltype(unref(std::declval<T&>()))>;
+
+    if constexpr (IsRadixKeyV<V>) {
+        return sort_by_key<true>(std::move(items), [](const T& item) { return unref(item); });
+    } else {
+        auto less = [](const T& l, const T& r) {
+            return vce::compare(unref(l), unref(r)) == Ordering::Less;
+        };
+        std::stable_sort(items.begin(), items.end(), less);
+        return items;
+    }
+}
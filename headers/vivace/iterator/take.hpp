@@ -18,6 +18,9 @@ class Take : public Iterator<T, Take<T, I>> {
     size_t n;
 
 protected:
+    /// Whether the exact size of this iterator is known.
+    static constexpr bool SIZED = I::HAS_SIZE;
+
     Bounds bounds_impl() const {
         auto bounds = source.bounds();
         auto lower = std::min(bounds.lower, n);
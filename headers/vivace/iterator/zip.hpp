@@ -18,6 +18,9 @@ class Zip : public Iterator<T, Zip<T, L, R>> {
     R right;
 
 protected:
+    /// Whether the exact size of this iterator is known.
+    static constexpr bool SIZED = L::HAS_SIZE && R::HAS_SIZE;
+
     Bounds bounds_impl() const {
         auto lbounds = left.bounds();
         auto rbounds = right.bounds();
@@ -16,9 +16,41 @@
 #define VCE_MATH_HPP
 
 #include <vivace/option.hpp>
+#include <vivace/simd.hpp>
+
+#include <algorithm>
+#include <utility>
 
 namespace vce {
 
+/// A signed 128-bit integer.
+__extension__ typedef __int128 Int128;
+
+/// An unsigned 128-bit integer.
+__extension__ typedef unsigned __int128 Uint128;
+
+namespace detail {
+    /// Returns the first supplied value if the supplied condition is true or the second supplied
+    /// value otherwise without branching.
+    template <class T>
+    constexpr T select(bool condition, T yes, T no) {
+        using U = std::make_unsigned_t<T>;
+        auto mask = static_cast<U>(U{0} - static_cast<U>(condition));
+        return static_cast<T>((static_cast<U>(yes) & mask) | (static_cast<U>(no) & ~mask));
+    }
+
+    /// Returns whether dividing the two supplied values is undefined or overflows.
+    template <class T>
+    constexpr bool invalid_division(T left, T right) {
+        auto zero = right == static_cast<T>(0);
+        if constexpr (std::is_signed_v<T>) {
+            return zero | ((left == Limits<T>::min()) & (right == static_cast<T>(-1)));
+        } else {
+            return zero;
+        }
+    }
+}
+
 /// Returns the sum of the two supplied values unless the sum overflows.
 template <class T>
 Option<T> checked_add(T left, T right) {
@@ -49,26 +81,277 @@ Option<T> checked_mul(T left, T right) {
     }
 }
 
-/// Returns the quotient of the two supplied values unless the denominator is zero.
+/// Returns the quotient of the two supplied values unless the denominator is zero or the quotient
+/// overflows.
 template <class T>
 Option<T> checked_div(T left, T right) {
-    if (right != static_cast<T>(0)) {
+    if (!detail::invalid_division(left, right)) {
         return {left / right};
     } else {
         return {};
     }
 }
 
+/// Returns the remainder of the two supplied values unless the denominator is zero or the quotient
+/// overflows.
+template <class T>
+Option<T> checked_rem(T left, T right) {
+    if (!detail::invalid_division(left, right)) {
+        return {left % right};
+    } else {
+        return {};
+    }
+}
+
+/// Returns the negation of the supplied value unless the negation overflows.
+template <class T>
+Option<T> checked_neg(T value) {
+    if (!__builtin_sub_overflow(static_cast<T>(0), value, &value)) {
+        return {value};
+    } else {
+        return {};
+    }
+}
+
+/// Returns the supplied value shifted left by the supplied number of bits unless the number of bits
+/// is not less than the width of the value.
+template <class T>
+Option<T> checked_shl(T value, uint32_t shift) {
+    if (shift < 8 * sizeof(T)) {
+        using U = std::make_unsigned_t<T>;
+        return {static_cast<T>(static_cast<U>(static_cast<U>(value) << shift))};
+    } else {
+        return {};
+    }
+}
+
+/// Returns the supplied value shifted right by the supplied number of bits unless the number of
+/// bits is not less than the width of the value.
+template <class T>
+Option<T> checked_shr(T value, uint32_t shift) {
+    if (shift < 8 * sizeof(T)) {
+        return {static_cast<T>(value >> shift)};
+    } else {
+        return {};
+    }
+}
+
+/// Returns the supplied value raised to the supplied power unless the power overflows.
+template <class T>
+Option<T> checked_pow(T base, uint32_t exponent) {
+    auto result = static_cast<T>(1);
+    auto overflow = false;
+    while (exponent > 1) {
+        auto factor = detail::select((exponent & 1) != 0, base, static_cast<T>(1));
+        overflow |= __builtin_mul_overflow(result, factor, &result);
+        overflow |= __builtin_mul_overflow(base, base, &base);
+        exponent >>= 1;
+    }
+    auto factor = detail::select(exponent != 0, base, static_cast<T>(1));
+    overflow |= __builtin_mul_overflow(result, factor, &result);
+
+    if (!overflow) {
+        return {result};
+    } else {
+        return {};
+    }
+}
+
+namespace detail {
+    /// Returns the lanes of the supplied sum with their highest bits set where it overflowed.
+    template <class T, class V>
+    V add_overflow(V left, V right, V sum) {
+        if constexpr (std::is_signed_v<T>) {
+            return (left ^ sum) & (right ^ sum);
+        } else {
+            return (left & right) | ((left | right) & ~sum);
+        }
+    }
+
+    /// Returns the lanes of the supplied difference with their highest bits set where it
+    /// overflowed.
+    template <class T, class V>
+    V sub_overflow(V left, V right, V difference) {
+        if constexpr (std::is_signed_v<T>) {
+            return (left ^ right) & (left ^ difference);
+        } else {
+            return (~left & right) | ((~left | right) & difference);
+        }
+    }
+
+    template <class T, class F, class G>
+    Option<size_t> checked_zip(Span<const T> left, Span<const T> right, Span<T> out, F f, G g) {
+        using U = std::make_unsigned_t<T>;
+        using S = Simd<U>;
+
+        auto size = std::min({left.size(), right.size(), out.size()});
+        auto l = reinterpret_cast<const U*>(left.data());
+        auto r = reinterpret_cast<const U*>(right.data());
+        auto o = reinterpret_cast<U*>(out.data());
+
+        // Overflow is checked once per group of vectors, and a group or vector which overflows is
+        // processed again by the narrower loops that follow to find the first overflow.
+        static constexpr size_t GROUP = 4 * S::LANES;
+
+        size_t i = 0;
+        for (; i + GROUP <= size; i += GROUP) {
+            typename S::type any = {};
+            for (size_t j = i; j < i + GROUP; j += S::LANES) {
+                typename S::type overflow;
+                S::store(o + j, f(S::load(l + j), S::load(r + j), overflow));
+                any |= overflow;
+            }
+            if (VCE_UNLIKELY(S::any_high(any))) {
+                break;
+            }
+        }
+
+        for (; i + S::LANES <= size; i += S::LANES) {
+            typename S::type overflow;
+            S::store(o + i, f(S::load(l + i), S::load(r + i), overflow));
+            if (VCE_UNLIKELY(S::any_high(overflow))) {
+                break;
+            }
+        }
+
+        for (; i < size; ++i) {
+            if (g(left[i], right[i], &out[i])) {
+                return {i};
+            }
+        }
+
+        return {};
+    }
+}
+
+/// Stores the sums of the pairs of values in the supplied views in the supplied output view and
+/// returns the index of the first sum that overflows, if any.
+///
+/// Only as many pairs as fit in the shortest view are added and the output values at and after the
+/// first overflow are unspecified.
+template <class T>
+Option<size_t> checked_add(Span<const T> left, Span<const T> right, Span<T> out) {
+    auto f = [](auto l, auto r, auto& overflow) {
+        auto sum = l + r;
+        overflow = detail::add_overflow<T>(l, r, sum);
+        return sum;
+    };
+    auto g = [](T l, T r, T* sum) { return __builtin_add_overflow(l, r, sum); };
+    return detail::checked_zip<T>(left, right, out, f, g);
+}
+
+/// Stores the differences of the pairs of values in the supplied views in the supplied output view
+/// and returns the index of the first difference that overflows, if any.
+///
+/// Only as many pairs as fit in the shortest view are subtracted and the output values at and after
+/// the first overflow are unspecified.
+template <class T>
+Option<size_t> checked_sub(Span<const T> left, Span<const T> right, Span<T> out) {
+    auto f = [](auto l, auto r, auto& overflow) {
+        auto difference = l - r;
+        overflow = detail::sub_overflow<T>(l, r, difference);
+        return difference;
+    };
+    auto g = [](T l, T r, T* difference) { return __builtin_sub_overflow(l, r, difference); };
+    return detail::checked_zip<T>(left, right, out, f, g);
+}
+
+/// Returns the sum of the values in the supplied view unless the sum overflows.
+///
+/// Only the exact sum has to be representable, so unlike a fold over `checked_add` a signed sum
+/// which leaves and then reenters the representable range does not overflow.
+template <class T>
+Option<T> checked_sum(Span<const T> values) {
+    static constexpr size_t BLOCK = 256;
+
+    auto size = values.size();
+    auto data = values.data();
+
+    if constexpr (sizeof(T) < sizeof(int64_t)) {
+        using W = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+
+        // Blocks are summed with fixed trip counts so that they are vectorized and a block sum can
+        // not overflow the 64-bit accumulator.
+        W total = 0;
+        size_t i = 0;
+        for (; i + BLOCK <= size; i += BLOCK) {
+            W sum = 0;
+            for (size_t j = 0; j < BLOCK; ++j) {
+                sum += data[i + j];
+            }
+            if (__builtin_add_overflow(total, sum, &total)) {
+                return {};
+            }
+        }
+        for (; i < size; ++i) {
+            if (__builtin_add_overflow(total, data[i], &total)) {
+                return {};
+            }
+        }
+
+        if (total >= Limits<T>::min() && total <= Limits<T>::max()) {
+            return {static_cast<T>(total)};
+        } else {
+            return {};
+        }
+    } else {
+        using S = detail::Simd<uint64_t>;
+
+        // Each lane accumulates an exact 128-bit sum split into low and high words.
+        auto words = reinterpret_cast<const uint64_t*>(data);
+        typename S::type low = {};
+        typename S::type high = {};
+        size_t i = 0;
+        for (; i + S::LANES <= size; i += S::LANES) {
+            auto value = S::load(words + i);
+            auto sum = low + value;
+            high += ((low & value) | ((low | value) & ~sum)) >> 63;
+            if constexpr (std::is_signed_v<T>) {
+                high -= value >> 63;
+            }
+            low = sum;
+        }
+
+        Uint128 total = 0;
+        for (size_t lane = 0; lane < S::LANES; ++lane) {
+            total += (static_cast<Uint128>(high[lane]) << 64) | low[lane];
+        }
+        for (; i < size; ++i) {
+            if constexpr (std::is_signed_v<T>) {
+                total += static_cast<Uint128>(static_cast<Int128>(data[i]));
+            } else {
+                total += data[i];
+            }
+        }
+
+        if constexpr (std::is_signed_v<T>) {
+            auto exact = static_cast<Int128>(total);
+            if (exact >= Limits<T>::min() && exact <= Limits<T>::max()) {
+                return {static_cast<T>(exact)};
+            } else {
+                return {};
+            }
+        } else if (total <= Limits<T>::max()) {
+            return {static_cast<T>(total)};
+        } else {
+            return {};
+        }
+    }
+}
+
 /// Returns the sum of the two supplied values or the closest representable value to the real sum if
 /// the sum overflows.
 template <class T>
 T saturating_add(T left, T right) {
-    if (auto sum = checked_add(left, right); sum.is_some()) {
-        return sum.unwrap();
-    } else if (left < 0) {
-        return Limits<T>::min();
+    T sum;
+    auto overflow = __builtin_add_overflow(left, right, &sum);
+    if constexpr (std::is_signed_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        auto negative = static_cast<U>(left) >> (8 * sizeof(T) - 1);
+        auto saturated = static_cast<T>(static_cast<U>(Limits<T>::max()) + negative);
+        return detail::select(overflow, saturated, sum);
     } else {
-        return Limits<T>::max();
+        return detail::select(overflow, Limits<T>::max(), sum);
     }
 }
 
@@ -76,12 +359,15 @@ T saturating_add(T left, T right) {
 /// difference if the difference overflows.
 template <class T>
 T saturating_sub(T left, T right) {
-    if (auto difference = checked_sub(left, right); difference.is_some()) {
-        return difference.unwrap();
-    } else if (left < right) {
-        return Limits<T>::min();
+    T difference;
+    auto overflow = __builtin_sub_overflow(left, right, &difference);
+    if constexpr (std::is_signed_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        auto negative = static_cast<U>(left) >> (8 * sizeof(T) - 1);
+        auto saturated = static_cast<T>(static_cast<U>(Limits<T>::max()) + negative);
+        return detail::select(overflow, saturated, difference);
     } else {
-        return Limits<T>::max();
+        return detail::select(overflow, Limits<T>::min(), difference);
     }
 }
 
@@ -89,12 +375,220 @@ T saturating_sub(T left, T right) {
 /// product if the product overflows.
 template <class T>
 T saturating_mul(T left, T right) {
-    if (auto product = checked_mul(left, right); product.is_some()) {
-        return product.unwrap();
-    } else if ((left < 0) != (right < 0)) {
-        return Limits<T>::min();
+    T product;
+    auto overflow = __builtin_mul_overflow(left, right, &product);
+    if constexpr (std::is_signed_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        auto negative = (static_cast<U>(left) ^ static_cast<U>(right)) >> (8 * sizeof(T) - 1);
+        auto saturated = static_cast<T>(static_cast<U>(Limits<T>::max()) + negative);
+        return detail::select(overflow, saturated, product);
     } else {
-        return Limits<T>::max();
+        return detail::select(overflow, Limits<T>::max(), product);
+    }
+}
+
+/// Returns the sum of the two supplied values and whether the sum overflowed.
+///
+/// The sum wraps around at the bounds of the type if it overflows.
+template <class T>
+constexpr std::pair<T, bool> overflowing_add(T left, T right) {
+    T sum{};
+    auto overflow = __builtin_add_overflow(left, right, &sum);
+    return {sum, overflow};
+}
+
+/// Returns the difference of the two supplied values and whether the difference overflowed.
+///
+/// The difference wraps around at the bounds of the type if it overflows.
+template <class T>
+constexpr std::pair<T, bool> overflowing_sub(T left, T right) {
+    T difference{};
+    auto overflow = __builtin_sub_overflow(left, right, &difference);
+    return {difference, overflow};
+}
+
+/// Returns the product of the two supplied values and whether the product overflowed.
+///
+/// The product wraps around at the bounds of the type if it overflows.
+template <class T>
+constexpr std::pair<T, bool> overflowing_mul(T left, T right) {
+    T product{};
+    auto overflow = __builtin_mul_overflow(left, right, &product);
+    return {product, overflow};
+}
+
+/// Returns the negation of the supplied value and whether the negation overflowed.
+///
+/// The negation wraps around at the bounds of the type if it overflows.
+template <class T>
+constexpr std::pair<T, bool> overflowing_neg(T value) {
+    return overflowing_sub(static_cast<T>(0), value);
+}
+
+/// Returns the sum of the two supplied values wrapped around at the bounds of the type.
+template <class T>
+constexpr T wrapping_add(T left, T right) {
+    return overflowing_add(left, right).first;
+}
+
+/// Returns the difference of the two supplied values wrapped around at the bounds of the type.
+template <class T>
+constexpr T wrapping_sub(T left, T right) {
+    return overflowing_sub(left, right).first;
+}
+
+/// Returns the product of the two supplied values wrapped around at the bounds of the type.
+template <class T>
+constexpr T wrapping_mul(T left, T right) {
+    return overflowing_mul(left, right).first;
+}
+
+/// Returns the negation of the supplied value wrapped around at the bounds of the type.
+template <class T>
+constexpr T wrapping_neg(T value) {
+    return overflowing_neg(value).first;
+}
+
+/// Returns the supplied value shifted left by the supplied number of bits modulo the width of the
+/// value.
+template <class T>
+constexpr T wrapping_shl(T value, uint32_t shift) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<U>(static_cast<U>(value) << (shift & (8 * sizeof(T) - 1))));
+}
+
+/// Returns the supplied value shifted right by the supplied number of bits modulo the width of the
+/// value.
+template <class T>
+constexpr T wrapping_shr(T value, uint32_t shift) {
+    return static_cast<T>(value >> (shift & (8 * sizeof(T) - 1)));
+}
+
+namespace detail {
+    /// The integer type with the supplied size and signedness.
+    template <size_t SIZE, bool SIGNED>
+    struct Integer;
+
+    template <> struct Integer<2, true> { using type = int16_t; };
+    template <> struct Integer<2, false> { using type = uint16_t; };
+    template <> struct Integer<4, true> { using type = int32_t; };
+    template <> struct Integer<4, false> { using type = uint32_t; };
+    template <> struct Integer<8, true> { using type = int64_t; };
+    template <> struct Integer<8, false> { using type = uint64_t; };
+    template <> struct Integer<16, true> { using type = Int128; };
+    template <> struct Integer<16, false> { using type = Uint128; };
+
+    /// The integer type twice as wide as the supplied integer type.
+    template <class T>
+    using Wide = typename Integer<2 * sizeof(T), std::is_signed_v<T>>::type;
+}
+
+/// Returns the product of the two supplied values in an integer type twice as wide as the values.
+///
+/// The product can not overflow.
+template <class T>
+constexpr detail::Wide<T> widening_mul(T left, T right) {
+    using W = detail::Wide<T>;
+    return static_cast<W>(static_cast<W>(left) * static_cast<W>(right));
+}
+
+/// Returns the absolute difference of the two supplied values.
+///
+/// The difference is returned as an unsigned integer so it can not overflow.
+template <class T>
+constexpr std::make_unsigned_t<T> abs_diff(T left, T right) {
+    using U = std::make_unsigned_t<T>;
+    auto forward = static_cast<U>(static_cast<U>(left) - static_cast<U>(right));
+    auto backward = static_cast<U>(static_cast<U>(right) - static_cast<U>(left));
+    return detail::select(left < right, backward, forward);
+}
+
+namespace detail {
+    template <class T, class F, class G>
+    void zip(Span<const T> left, Span<const T> right, Span<T> out, F f, G g) {
+        using U = std::make_unsigned_t<T>;
+        using S = Simd<U>;
+
+        auto size = std::min({left.size(), right.size(), out.size()});
+        auto l = reinterpret_cast<const U*>(left.data());
+        auto r = reinterpret_cast<const U*>(right.data());
+        auto o = reinterpret_cast<U*>(out.data());
+
+        size_t i = 0;
+        for (; i + S::LANES <= size; i += S::LANES) {
+            S::store(o + i, f(S::load(l + i), S::load(r + i)));
+        }
+
+        for (; i < size; ++i) {
+            out[i] = g(left[i], right[i]);
+        }
+    }
+
+    /// Returns the lanes which should replace those which overflowed in a saturating operation.
+    template <class T, class V>
+    V saturated(V sign) {
+        using U = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T>) {
+            return Simd<U>::splat(Limits<T>::max()) + (sign >> (8 * sizeof(T) - 1));
+        } else {
+            return ~V{};
+        }
+    }
+}
+
+/// Stores the saturating sums of the pairs of values in the supplied views in the supplied output
+/// view.
+///
+/// Only as many pairs as fit in the shortest view are added.
+template <class T>
+void saturating_add(Span<const T> left, Span<const T> right, Span<T> out) {
+    auto f = [](auto l, auto r) {
+        using S = detail::Simd<std::make_unsigned_t<T>>;
+        if constexpr (detail::NATIVE_SATURATION && sizeof(T) <= 2) {
+            return detail::native_saturating_add<T>(l, r);
+        } else {
+            auto sum = l + r;
+            auto mask = S::spread_high(detail::add_overflow<T>(l, r, sum));
+            return (sum & ~mask) | (detail::saturated<T>(l) & mask);
+        }
+    };
+    auto g = [](T l, T r) { return saturating_add(l, r); };
+    detail::zip<T>(left, right, out, f, g);
+}
+
+/// Stores the saturating differences of the pairs of values in the supplied views in the supplied
+/// output view.
+///
+/// Only as many pairs as fit in the shortest view are subtracted.
+template <class T>
+void saturating_sub(Span<const T> left, Span<const T> right, Span<T> out) {
+    auto f = [](auto l, auto r) {
+        using S = detail::Simd<std::make_unsigned_t<T>>;
+        if constexpr (detail::NATIVE_SATURATION && sizeof(T) <= 2) {
+            return detail::native_saturating_sub<T>(l, r);
+        } else {
+            auto difference = l - r;
+            auto mask = S::spread_high(detail::sub_overflow<T>(l, r, difference));
+            if constexpr (std::is_signed_v<T>) {
+                return (difference & ~mask) | (detail::saturated<T>(l) & mask);
+            } else {
+                return difference & ~mask;
+            }
+        }
+    };
+    auto g = [](T l, T r) { return saturating_sub(l, r); };
+    detail::zip<T>(left, right, out, f, g);
+}
+
+/// Stores the saturating products of the pairs of values in the supplied views in the supplied
+/// output view.
+///
+/// Only as many pairs as fit in the shortest view are multiplied.
+template <class T>
+void saturating_mul(Span<const T> left, Span<const T> right, Span<T> out) {
+    auto size = std::min({left.size(), right.size(), out.size()});
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = saturating_mul(left[i], right[i]);
     }
 }
 
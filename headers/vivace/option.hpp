@@ -28,6 +28,10 @@ namespace detail {
         std::is_constructible_v<T, U&&> &&
         !std::is_same_v<std::decay_t<U>, std::in_place_t> &&
         !std::is_same_v<std::decay_t<U>, Option<T>>;
+
+    template <class T, class U>
+    static constexpr bool IsOptionConvertibleV =
+        std::is_same_v<T, U> || !std::is_constructible_v<T, Option<U>&&>;
 }
 
 /// A type that may or may not contain a value.
@@ -36,6 +40,8 @@ class Option {
     template <class U>
     friend class Option;
 
+    friend struct detail::Try;
+
     bool some;
     std::aligned_storage_t<sizeof(T), alignof(T)> value;
 
@@ -67,11 +73,14 @@ public:
         new(&value) T(list, std::forward<N>(arguments)...);
     }
 
+    /// Constructs an empty option as propagated by `VCE_TRY`.
+    Option(detail::Residual<Unit>) : some{false} { }
+
     Option(const Option& other) : some{other.some} {
         copy(other);
     }
 
-    template <class U>
+    template <class U, Sfinae<detail::IsOptionConvertibleV<T, U>> = 0>
     Option(const Option<U>& other) : some{other.some} {
         copy(other);
     }
@@ -80,7 +89,7 @@ public:
         return operator=<T>(other);
     }
 
-    template <class U>
+    template <class U, Sfinae<detail::IsOptionConvertibleV<T, U>> = 0>
     Option& operator=(const Option<U>& other) {
         destroy();
         some = other.some;
@@ -92,7 +101,7 @@ public:
         move(std::move(other));
     }
 
-    template <class U>
+    template <class U, Sfinae<detail::IsOptionConvertibleV<T, U>> = 0>
     Option(Option<U>&& other) : some{other.some} {
         move(std::move(other));
     }
@@ -101,7 +110,7 @@ public:
         return operator=<T>(std::move(other));
     }
 
-    template <class U>
+    template <class U, Sfinae<detail::IsOptionConvertibleV<T, U>> = 0>
     Option& operator=(Option<U>&& other) {
         destroy();
         if (other.some) {
@@ -128,7 +137,7 @@ public:
     /// Returns a reference to the value in this option if possible.
     Option<Ref<T>> as_ref() {
         if (some) {
-            return {std::ref(unsafe_get())};
+            return {Ref<T>{unsafe_get()}};
         } else {
             return {};
         }
@@ -137,7 +146,7 @@ public:
     /// Returns a reference to the value in this option if possible.
     Option<Ref<const T>> as_ref() const {
         if (some) {
-            return {std::cref(unsafe_get())};
+            return {Ref<const T>{unsafe_get()}};
         } else {
             return {};
         }
@@ -145,10 +154,10 @@ public:
 
     /// Returns the value in this option or throws an exception if this option is empty.
     T unwrap() {
-        if (some) {
+        if (VCE_LIKELY(some)) {
             return unsafe_unwrap();
         } else {
-            throw std::logic_error{"attempted to unwrap the value in an empty option"};
+            detail::panic("attempted to unwrap the value in an empty option");
         }
     }
 
@@ -250,10 +259,14 @@ public:
 
     /// Returns the hash code for this option.
     size_t hash() const {
-        if (some) {
-            return std::hash<T>{}(unsafe_get());
-        } else {
-            return 0;
+        return Hash{}(*this);
+    }
+
+    /// Combines the supplied option with the state of the supplied hasher.
+    friend void hash_combine(Hasher& hasher, const Option& option) {
+        hasher.write(option.some);
+        if (option.some) {
+            hash_combine(hasher, option.unsafe_get());
         }
     }
 
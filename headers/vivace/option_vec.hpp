@@ -0,0 +1,271 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_OPTION_VEC_HPP
+#define VCE_OPTION_VEC_HPP
+
+#include <vivace/iterator.hpp>
+#include <vivace/vec.hpp>
+
+#include <cstdint>
+
+namespace vce {
+
+template <class T>
+class OptionVec;
+
+namespace detail {
+    template <class T>
+    class OptionVecIterator : public Iterator<Option<Ref<const T>>, OptionVecIterator<T>> {
+        const OptionVec<T>* options;
+        size_t front;
+        size_t back;
+        size_t front_value;
+        size_t back_value;
+
+    protected:
+        Bounds bounds_impl() const {
+            return {size_impl(), size_impl()};
+        }
+
+        size_t size_impl() const {
+            return back - front;
+        }
+
+        Option<Option<Ref<const T>>> next_impl() {
+            if (front != back) {
+                auto index = front;
+                front += 1;
+                if (options->is_some(index)) {
+                    return {std::cref(options->values[front_value++])};
+                } else {
+                    return {Option<Ref<const T>>{}};
+                }
+            } else {
+                return {};
+            }
+        }
+
+        Option<Option<Ref<const T>>> next_back_impl() {
+            if (front != back) {
+                back -= 1;
+                if (options->is_some(back)) {
+                    return {std::cref(options->values[--back_value])};
+                } else {
+                    return {Option<Ref<const T>>{}};
+                }
+            } else {
+                return {};
+            }
+        }
+
+    public:
+        OptionVecIterator(const OptionVec<T>* options) :
+            options{options},
+            front{0},
+            back{options->size()},
+            front_value{0},
+            back_value{options->values.size()} { }
+    };
+
+    template <class T>
+    class SomesIterator : public Iterator<std::pair<size_t, Ref<const T>>, SomesIterator<T>> {
+        using Item = std::pair<size_t, Ref<const T>>;
+
+        const OptionVec<T>* options;
+        size_t remaining;
+        size_t front_word;
+        size_t back_word;
+        uint64_t front_bits;
+        uint64_t back_bits;
+        size_t front_value;
+        size_t back_value;
+
+    protected:
+        Bounds bounds_impl() const {
+            return {remaining, remaining};
+        }
+
+        size_t size_impl() const {
+            return remaining;
+        }
+
+        Option<Item> next_impl() {
+            if (remaining != 0) {
+                while (front_bits == 0) {
+                    front_word += 1;
+                    front_bits = options->words[front_word];
+                }
+                auto bit = static_cast<size_t>(__builtin_ctzll(front_bits));
+                front_bits &= front_bits - 1;
+                remaining -= 1;
+                auto index = front_word * 64 + bit;
+                return {std::make_pair(index, std::cref(options->values[front_value++]))};
+            } else {
+                return {};
+            }
+        }
+
+        Option<Item> next_back_impl() {
+            if (remaining != 0) {
+                while (back_bits == 0) {
+                    back_word -= 1;
+                    back_bits = options->words[back_word];
+                }
+                auto bit = static_cast<size_t>(63 - __builtin_clzll(back_bits));
+                back_bits &= ~(uint64_t{1} << bit);
+                remaining -= 1;
+                auto index = back_word * 64 + bit;
+                return {std::make_pair(index, std::cref(options->values[--back_value]))};
+            } else {
+                return {};
+            }
+        }
+
+    public:
+        SomesIterator(const OptionVec<T>* options) :
+            options{options},
+            remaining{options->values.size()},
+            front_word{0},
+            back_word{0},
+            front_bits{0},
+            back_bits{0},
+            front_value{0},
+            back_value{options->values.size()}
+        {
+            if (!options->words.empty()) {
+                back_word = options->words.size() - 1;
+                front_bits = options->words[0];
+                back_bits = options->words[back_word];
+            }
+        }
+    };
+}
+
+/// A sequence of options which stores the values that are present contiguously and tracks which
+/// options are present in a separate bitmap.
+template <class T>
+class OptionVec {
+    friend class detail::OptionVecIterator<T>;
+    friend class detail::SomesIterator<T>;
+
+    Vec<T> values;
+    Vec<uint64_t> words;
+    Vec<size_t> ranks;
+    size_t size_;
+
+public:
+    using value_type = Option<T>;
+
+    /// Whether this type may be safely moved to another location in memory.
+    static constexpr bool RELOCATABLE = true;
+
+    /// Constructs an empty sequence.
+    OptionVec() : size_{0} { }
+
+    /// Constructs a sequence containing the supplied options.
+    OptionVec(std::initializer_list<Option<T>> list) : OptionVec{} {
+        reserve(list.size());
+        for (const auto& option : list) {
+            push_back(option);
+        }
+    }
+
+    /// Returns the number of options in this sequence.
+    size_t size() const {
+        return size_;
+    }
+
+    /// Returns whether this sequence contains no options.
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /// Returns the number of options in this sequence which contain values.
+    size_t count_some() const {
+        return values.size();
+    }
+
+    /// Returns whether the option at the supplied index contains a value, which is false for
+    /// indices past the end of this sequence.
+    bool is_some(size_t index) const {
+        return index < size_ && ((words[index / 64] >> (index % 64)) & 1);
+    }
+
+    /// Returns a reference to the value in the option at the supplied index, if any, which is none
+    /// for indices past the end of this sequence.
+    Option<Ref<const T>> get(size_t index) const {
+        if (is_some(index)) {
+            auto below = words[index / 64] & ((uint64_t{1} << (index % 64)) - 1);
+            auto rank = ranks[index / 64] + static_cast<size_t>(__builtin_popcountll(below));
+            return {std::cref(values[rank])};
+        } else {
+            return {};
+        }
+    }
+
+    /// Ensures this sequence can contain at least the supplied number of options without
+    /// reallocating its bitmap.
+    void reserve(size_t capacity) {
+        words.reserve((capacity + 63) / 64);
+        ranks.reserve((capacity + 63) / 64);
+    }
+
+    /// Adds the supplied option to the end of this sequence.
+    void push_back(Option<T> option) {
+        if (size_ % 64 == 0) {
+            words.push_back(0);
+            ranks.push_back(values.size());
+        }
+        if (option.is_some()) {
+            words[size_ / 64] |= uint64_t{1} << (size_ % 64);
+            values.push_back(option.unwrap());
+        }
+        size_ += 1;
+    }
+
+    /// Removes all of the options in this sequence.
+    void clear() {
+        values.clear();
+        words.clear();
+        ranks.clear();
+        size_ = 0;
+    }
+
+    /// Returns an iterator over references to the values in the options in this sequence.
+    detail::OptionVecIterator<T> iter() const {
+        return {this};
+    }
+
+    /// Returns an iterator over the indices of the options in this sequence which contain values
+    /// and references to those values.
+    detail::SomesIterator<T> somes() const {
+        return {this};
+    }
+
+    friend bool operator==(const OptionVec& left, const OptionVec& right) {
+        return left.size_ == right.size_ &&
+            left.words == right.words &&
+            left.values == right.values;
+    }
+
+    friend bool operator!=(const OptionVec& left, const OptionVec& right) {
+        return !operator==(left, right);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,229 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_PARSE_HPP
+#define VCE_PARSE_HPP
+
+#include <vivace/iterator.hpp>
+#include <vivace/result.hpp>
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace vce {
+
+/// An error which occurred while parsing a number.
+class ParseError {
+public:
+    /// A kind of error which occurred while parsing a number.
+    enum class Kind {
+        /// The string was empty.
+        Empty,
+        /// The string contained a character which is not part of a number.
+        Invalid,
+        /// The number can't be represented by the type being parsed.
+        OutOfRange,
+    };
+
+private:
+    Kind kind_;
+    size_t position_;
+
+public:
+    /// Constructs an error of the supplied kind which occurred at the supplied index.
+    ParseError(Kind kind, size_t position) : kind_{kind}, position_{position} { }
+
+    /// Returns the kind of this error.
+    Kind kind() const {
+        return kind_;
+    }
+
+    /// Returns the index of the first character which is not part of a number or zero for errors
+    /// which are not caused by an invalid character.
+    size_t position() const {
+        return position_;
+    }
+
+    friend bool operator==(ParseError left, ParseError right) {
+        return left.kind_ == right.kind_ && left.position_ == right.position_;
+    }
+
+    friend bool operator!=(ParseError left, ParseError right) {
+        return !(left == right);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, ParseError error);
+};
+
+namespace detail {
+    /// Parses the eight ASCII digits at the supplied address into the supplied integer.
+    ///
+    /// The digits are parsed in parallel within a 64-bit word: the digits are validated with two
+    /// masks and then adjacent digits, pairs of digits and quadruples of digits are combined with
+    /// three multiplications. Returns whether all of the characters are digits.
+    inline bool parse_eight(const char* data, uint64_t& value) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+
+        // A byte is a digit if its high nibble is 3 and adding 6 to it doesn't carry out of its
+        // low nibble.
+        constexpr uint64_t HIGH = 0xF0F0F0F0F0F0F0F0;
+        auto nibbles = (word & HIGH) | (((word + 0x0606060606060606) & HIGH) >> 4);
+        if (nibbles != 0x3333333333333333) {
+            return false;
+        }
+
+        word -= 0x3030303030303030;
+        word = word * 10 + (word >> 8);
+        constexpr uint64_t PAIRS = 0x000000FF000000FF;
+        constexpr uint64_t HUNDREDS = 100 + (1000000ull << 32);
+        constexpr uint64_t ONES = 1 + (10000ull << 32);
+        value = ((word & PAIRS) * HUNDREDS + ((word >> 16) & PAIRS) * ONES) >> 32;
+        return true;
+    }
+
+    /// Parses the supplied digits into the supplied integer if there are eight or sixteen of them.
+    ///
+    /// Returns whether the digits were parsed.
+    inline bool parse_fast(const char* data, size_t size, uint64_t& value) {
+        if (size == 8) {
+            return parse_eight(data, value);
+        } else if (size == 16) {
+            uint64_t low;
+            if (parse_eight(data, value) && parse_eight(data + 8, low)) {
+                value = value * 100000000 + low;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Parses the supplied characters with `std::from_chars`.
+    template <class T>
+    Result<T, ParseError> from_chars(const char* data, size_t size) {
+        T value;
+        auto [end, code] = std::from_chars(data, data + size, value);
+        if (code == std::errc::result_out_of_range) {
+            return {ERR, ParseError{ParseError::Kind::OutOfRange, 0}};
+        } else if (code != std::errc{} || end != data + size) {
+            return {ERR, ParseError{ParseError::Kind::Invalid, static_cast<size_t>(end - data)}};
+        } else {
+            return {OK, value};
+        }
+    }
+
+    template <class T>
+    Result<T, ParseError> parse_integer(const char* data, size_t size) {
+        if constexpr (std::numeric_limits<T>::digits10 >= 8) {
+            auto negative = std::is_signed_v<T> && data[0] == '-';
+            auto sign = negative ? 1 : 0;
+            uint64_t magnitude;
+            if (parse_fast(data + sign, size - sign, magnitude)) {
+                using U = std::make_unsigned_t<T>;
+                auto max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+                if (magnitude > max + (negative ? 1 : 0)) {
+                    return {ERR, ParseError{ParseError::Kind::OutOfRange, 0}};
+                }
+                auto value = static_cast<U>(magnitude);
+                return {OK, static_cast<T>(negative ? U{0} - value : value)};
+            }
+        }
+
+        return from_chars<T>(data, size);
+    }
+
+    /// An iterator which parses the strings emitted by an iterator until one can't be parsed.
+    template <class T, class I>
+    class ParseAll : public Iterator<Result<T, ParseError>, ParseAll<T, I>> {
+        I source;
+        bool done;
+
+    protected:
+        Bounds bounds_impl() const {
+            if (done) {
+                return {0, 0};
+            } else {
+                auto bounds = source.bounds();
+                return {std::min<size_t>(bounds.lower, 1), bounds.upper};
+            }
+        }
+
+        Option<Result<T, ParseError>> next_impl();
+
+    public:
+        ParseAll(I source) : source{std::move(source)}, done{false} { }
+    };
+}
+
+/// Parses the supplied string as a number of the supplied integer or floating point type.
+///
+/// The whole string must be a number in base 10, optionally preceded by a sign, without any
+/// surrounding whitespace. Floating point numbers may also be written in scientific notation or as
+/// `inf` or `nan`. Integers with exactly eight or sixteen digits are parsed without a loop and all
+/// other numbers are parsed with `std::from_chars` so no memory is allocated, no exceptions are
+/// thrown and the locale is ignored.
+template <class T>
+Result<T, ParseError> parse(std::string_view string) {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+        "only integers and floating point numbers can be parsed");
+    if (string.empty()) {
+        return {ERR, ParseError{ParseError::Kind::Empty, 0}};
+    }
+
+    // `std::from_chars` doesn't accept a plus sign.
+    auto data = string.data();
+    auto size = string.size();
+    auto plus = data[0] == '+' && size > 1 && data[1] != '-' && data[1] != '+' ? 1 : 0;
+    auto result = [&] {
+        if constexpr (std::is_integral_v<T>) {
+            return detail::parse_integer<T>(data + plus, size - plus);
+        } else {
+            return detail::from_chars<T>(data + plus, size - plus);
+        }
+    }();
+    if (VCE_UNLIKELY(plus != 0 && result.is_err())) {
+        auto error = result.unwrap_err();
+        if (error.kind() == ParseError::Kind::Invalid) {
+            return {ERR, ParseError{error.kind(), error.position() + 1}};
+        }
+    }
+    return result;
+}
+
+template <class T, class I>
+Option<Result<T, ParseError>> detail::ParseAll<T, I>::next_impl() {
+    if (!done) {
+        auto item = source.next();
+        if (item.is_some()) {
+            auto result = parse<T>(detail::unref(item.unwrap()));
+            done = result.is_err();
+            return {std::move(result)};
+        }
+        done = true;
+    }
+    return {};
+}
+
+}
+
+#endif
@@ -15,6 +15,7 @@
 #ifndef VCE_RESULT_HPP
 #define VCE_RESULT_HPP
 
+#include <vivace/hash.hpp>
 #include <vivace/utility.hpp>
 
 namespace vce {
@@ -31,15 +32,71 @@ struct Err { };
 /// The only value of the err type.
 static constexpr Err ERR{};
 
+template <class T, class E>
+class Result;
+
 template <class T>
 class Option;
 
+namespace detail {
+    /// The part of a failed result or option which is propagated by `VCE_TRY`.
+    template <class E>
+    struct Residual {
+        E error;
+    };
+
+    /// Accesses the contents of results and options without rechecking them for `VCE_TRY`.
+    struct Try {
+        template <class T, class E>
+        static bool failed(const Result<T, E>& result) {
+            return !result.ok_;
+        }
+
+        template <class T, class E>
+        static T value(Result<T, E>& result) {
+            return result.unsafe_unwrap();
+        }
+
+        template <class T, class E>
+        static Residual<E> residual(Result<T, E>& result) {
+            return {result.unsafe_unwrap_err()};
+        }
+
+        template <class T>
+        static bool failed(const Option<T>& option) {
+            return !option.some;
+        }
+
+        template <class T>
+        static T value(Option<T>& option) {
+            return option.unsafe_unwrap();
+        }
+
+        template <class T>
+        static Residual<Unit> residual(Option<T>&) {
+            return {};
+        }
+    };
+}
+
+/// Evaluates the supplied result (or option) and returns the value it contains or returns the
+/// error it contains (or an empty option) from the enclosing function.
+#define VCE_TRY(...) __extension__ ({ \
+        auto vce_try = (__VA_ARGS__); \
+        if (VCE_UNLIKELY(::vce::detail::Try::failed(vce_try))) { \
+            return ::vce::detail::Try::residual(vce_try); \
+        } \
+        ::vce::detail::Try::value(vce_try); \
+    })
+
 /// A type that may contain either a value or an error.
 template <class T, class E>
 class Result {
     template <class U, class F>
     friend class Result;
 
+    friend struct detail::Try;
+
     bool ok_;
     std::aligned_union_t<0, T, E> either;
 
@@ -88,6 +145,12 @@ public:
         new(&either) E(list, std::forward<N>(arguments)...);
     }
 
+    /// Constructs a result containing the error propagated by `VCE_TRY`.
+    template <class F>
+    Result(detail::Residual<F>&& residual) : ok_{false} {
+        new(&either) E(std::move(residual.error));
+    }
+
     Result(const Result& other) : ok_{other.ok_} {
         copy(other);
     }
@@ -127,36 +190,36 @@ public:
     /// Returns a reference to the value or error in this result.
     Result<Ref<T>, Ref<E>> as_ref() {
         if (ok_) {
-            return {OK, std::ref(unsafe_get())};
+            return {OK, Ref<T>{unsafe_get()}};
         } else {
-            return {ERR, std::ref(unsafe_get_err())};
+            return {ERR, Ref<E>{unsafe_get_err()}};
         }
     }
 
     /// Returns a reference to the value or error in this result.
     Result<Ref<const T>, Ref<const E>> as_ref() const {
         if (ok_) {
-            return {OK, std::cref(unsafe_get())};
+            return {OK, Ref<const T>{unsafe_get()}};
         } else {
-            return {ERR, std::cref(unsafe_get_err())};
+            return {ERR, Ref<const E>{unsafe_get_err()}};
         }
     }
 
     /// Returns the value in this result or throws an exception if this result contains an error.
     T unwrap() {
-        if (ok_) {
+        if (VCE_LIKELY(ok_)) {
             return unsafe_unwrap();
         } else {
-            throw std::logic_error{"attempted to unwrap the value in a result containing an error"};
+            detail::panic("attempted to unwrap the value in a result containing an error");
         }
     }
 
     /// Returns the error in this result or throws an exception if this result contains a value.
     E unwrap_err() {
-        if (!ok_) {
+        if (VCE_LIKELY(!ok_)) {
             return unsafe_unwrap_err();
         } else {
-            throw std::logic_error{"attempted to unwrap the error in a result containing a value"};
+            detail::panic("attempted to unwrap the error in a result containing a value");
         }
     }
 
@@ -269,12 +332,16 @@ public:
 
     /// Returns the hash code for this result.
     size_t hash() const {
-        if (ok_) {
-            return std::hash<T>{}(unsafe_get());
+        return Hash{}(*this);
+    }
+
+    /// Combines the supplied result with the state of the supplied hasher.
+    friend void hash_combine(Hasher& hasher, const Result& result) {
+        hasher.write(result.ok_);
+        if (result.ok_) {
+            hash_combine(hasher, result.unsafe_get());
         } else {
-            auto code = std::hash<E>{}(unsafe_get_err());
-            code ^= 0x9e3779b9 + (code << 6) + (code >> 2);
-            return code;
+            hash_combine(hasher, result.unsafe_get_err());
         }
     }
 
@@ -0,0 +1,162 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_SIMD_HPP
+#define VCE_SIMD_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace vce::detail {
+
+/// The number of bytes in the vectors used by vectorized algorithms.
+#ifdef __AVX2__
+static constexpr size_t SIMD_BYTES = 32;
+#else
+static constexpr size_t SIMD_BYTES = 16;
+#endif
+
+/// A vector of the supplied type which is lowered to the widest supported SIMD registers.
+template <class T>
+struct Simd {
+    typedef T type __attribute__((vector_size(SIMD_BYTES)));
+
+    /// The number of lanes in a vector.
+    static constexpr size_t LANES = SIMD_BYTES / sizeof(T);
+
+    /// Loads a vector from the supplied possibly unaligned address.
+    static type load(const T* data) {
+        type vector;
+        std::memcpy(&vector, data, sizeof(vector));
+        return vector;
+    }
+
+    /// Stores a vector to the supplied possibly unaligned address.
+    static void store(T* data, type vector) {
+        std::memcpy(data, &vector, sizeof(vector));
+    }
+
+    /// Returns a vector with every lane set to the supplied value.
+    static type splat(T value) {
+        type vector = {};
+        return vector + value;
+    }
+
+    /// Returns a vector with every bit of each lane set to the highest bit of that lane.
+    static type spread_high(type vector) {
+        using U = std::make_unsigned_t<T>;
+        using V = typename Simd<U>::type;
+        return (type)-((V)vector >> (8 * sizeof(T) - 1));
+    }
+
+    /// Returns whether the highest bit of any lane in the supplied vector is set.
+    static bool any_high(type vector) {
+        using U = std::make_unsigned_t<T>;
+        using W = typename Simd<uint64_t>::type;
+        constexpr auto ONES = ~uint64_t{0} / std::numeric_limits<U>::max();
+        constexpr auto HIGH = ONES << (8 * sizeof(T) - 1);
+        auto words = (W)vector;
+        uint64_t any = 0;
+        for (size_t i = 0; i < Simd<uint64_t>::LANES; ++i) {
+            any |= words[i];
+        }
+        return (any & HIGH) != 0;
+    }
+};
+
+/// Returns a mask with a bit set for each lane of the supplied vector of bytes whose highest bit
+/// is set.
+inline uint32_t movemask(Simd<uint8_t>::type vector) {
+#if defined(__AVX2__)
+    return static_cast<uint32_t>(_mm256_movemask_epi8((__m256i)vector));
+#elif defined(__SSE2__)
+    return static_cast<uint32_t>(_mm_movemask_epi8((__m128i)vector));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < Simd<uint8_t>::LANES; ++i) {
+        mask |= static_cast<uint32_t>(vector[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+/// Whether saturating addition and subtraction of 8-bit and 16-bit lanes are native instructions.
+#if defined(__SSE2__)
+static constexpr bool NATIVE_SATURATION = true;
+#else
+static constexpr bool NATIVE_SATURATION = false;
+#endif
+
+/// Adds the 8-bit or 16-bit lanes of the supplied vectors with saturation.
+template <class T, class V>
+V native_saturating_add(V left, V right) {
+    static_assert(NATIVE_SATURATION && sizeof(T) <= 2);
+#if defined(__AVX2__)
+    auto l = (__m256i)left;
+    auto r = (__m256i)right;
+    if constexpr (sizeof(T) == 1) {
+        return (V)(std::is_signed_v<T> ? _mm256_adds_epi8(l, r) : _mm256_adds_epu8(l, r));
+    } else {
+        return (V)(std::is_signed_v<T> ? _mm256_adds_epi16(l, r) : _mm256_adds_epu16(l, r));
+    }
+#elif defined(__SSE2__)
+    auto l = (__m128i)left;
+    auto r = (__m128i)right;
+    if constexpr (sizeof(T) == 1) {
+        return (V)(std::is_signed_v<T> ? _mm_adds_epi8(l, r) : _mm_adds_epu8(l, r));
+    } else {
+        return (V)(std::is_signed_v<T> ? _mm_adds_epi16(l, r) : _mm_adds_epu16(l, r));
+    }
+#else
+    return left;
+#endif
+}
+
+/// Subtracts the 8-bit or 16-bit lanes of the supplied vectors with saturation.
+template <class T, class V>
+V native_saturating_sub(V left, V right) {
+    static_assert(NATIVE_SATURATION && sizeof(T) <= 2);
+#if defined(__AVX2__)
+    auto l = (__m256i)left;
+    auto r = (__m256i)right;
+    if constexpr (sizeof(T) == 1) {
+        return (V)(std::is_signed_v<T> ? _mm256_subs_epi8(l, r) : _mm256_subs_epu8(l, r));
+    } else {
+        return (V)(std::is_signed_v<T> ? _mm256_subs_epi16(l, r) : _mm256_subs_epu16(l, r));
+    }
+#elif defined(__SSE2__)
+    auto l = (__m128i)left;
+    auto r = (__m128i)right;
+    if constexpr (sizeof(T) == 1) {
+        return (V)(std::is_signed_v<T> ? _mm_subs_epi8(l, r) : _mm_subs_epu8(l, r));
+    } else {
+        return (V)(std::is_signed_v<T> ? _mm_subs_epi16(l, r) : _mm_subs_epu16(l, r));
+    }
+#else
+    return left;
+#endif
+}
+
+}
+
+#endif
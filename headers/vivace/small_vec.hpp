@@ -0,0 +1,280 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_SMALL_VEC_HPP
+#define VCE_SMALL_VEC_HPP
+
+#include <vivace/vec.hpp>
+
+namespace vce {
+
+/// A growable array which stores up to the supplied number of items inline before moving them to
+/// the heap.
+template <class T, size_t CAPACITY>
+class SmallVec {
+    static_assert(CAPACITY != 0, "a small vector must have room for at least one inline item");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned items are not supported");
+
+    T* heap;
+    size_t size_;
+    size_t capacity_;
+    std::aligned_storage_t<sizeof(T) * CAPACITY, alignof(T)> storage;
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /// Whether this type may be safely moved to another location in memory.
+    static constexpr bool RELOCATABLE = is_relocatable<T>();
+
+    /// Constructs an empty vector.
+    SmallVec() : heap{nullptr}, size_{0}, capacity_{CAPACITY} { }
+
+    /// Constructs a vector containing the supplied items.
+    SmallVec(std::initializer_list<T> list) : SmallVec{} {
+        reserve(list.size());
+        detail::copy(list.begin(), list.size(), data());
+        size_ = list.size();
+    }
+
+    SmallVec(const SmallVec& other) : SmallVec{} {
+        reserve(other.size_);
+        detail::copy(other.data(), other.size_, data());
+        size_ = other.size_;
+    }
+
+    SmallVec& operator=(const SmallVec& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            detail::copy(other.data(), other.size_, data());
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    SmallVec(SmallVec&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVec{} {
+        steal(std::move(other));
+    }
+
+    SmallVec& operator=(SmallVec&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            destroy();
+            steal(std::move(other));
+        }
+        return *this;
+    }
+
+    ~SmallVec() {
+        destroy();
+    }
+
+    /// Returns whether the items in this vector are stored inline.
+    bool is_inline() const {
+        return heap == nullptr;
+    }
+
+    /// Returns the number of items in this vector.
+    size_t size() const {
+        return size_;
+    }
+
+    /// Returns the number of items this vector can contain without reallocating.
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    /// Returns whether this vector contains no items.
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /// Returns a pointer to the items in this vector.
+    T* data() {
+        return heap != nullptr ? heap : reinterpret_cast<T*>(&storage);
+    }
+
+    /// Returns a pointer to the items in this vector.
+    const T* data() const {
+        return heap != nullptr ? heap : reinterpret_cast<const T*>(&storage);
+    }
+
+    T& operator[](size_t index) {
+        return data()[index];
+    }
+
+    const T& operator[](size_t index) const {
+        return data()[index];
+    }
+
+    T* begin() {
+        return data();
+    }
+
+    const T* begin() const {
+        return data();
+    }
+
+    T* end() {
+        return data() + size_;
+    }
+
+    const T* end() const {
+        return data() + size_;
+    }
+
+    /// Ensures this vector can contain at least the supplied number of items without reallocating.
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            reallocate(capacity);
+        }
+    }
+
+    /// Adds the supplied item to the end of this vector.
+    void push_back(T item) {
+        emplace_back(std::move(item));
+    }
+
+    /// Adds an item constructed from the supplied arguments to the end of this vector.
+    template <class... N>
+    T& emplace_back(N&&... arguments) {
+        if (VCE_UNLIKELY(size_ == capacity_)) {
+            return emplace_back_slow(std::forward<N>(arguments)...);
+        }
+        auto item = new(data() + size_) T(std::forward<N>(arguments)...);
+        size_ += 1;
+        return *item;
+    }
+
+    /// Removes and returns the item at the end of this vector, if any.
+    Option<T> pop_back() {
+        if (size_ != 0) {
+            size_ -= 1;
+            auto slot = data() + size_;
+            Option<T> item{std::move(*slot)};
+            slot->~T();
+            return item;
+        } else {
+            return {};
+        }
+    }
+
+    /// Inserts the supplied item at the supplied index, shifting the items after it to the right.
+    void insert(size_t index, T item) {
+        if (size_ == capacity_) {
+            grow();
+        }
+        detail::insert(data(), size_, index, std::move(item));
+        size_ += 1;
+    }
+
+    /// Removes the item at the supplied index, shifting the items after it to the left.
+    void erase(size_t index) {
+        detail::erase(data(), size_, index);
+        size_ -= 1;
+    }
+
+    /// Removes all of the items in this vector without releasing its memory.
+    void clear() {
+        detail::destroy(data(), size_);
+        size_ = 0;
+    }
+
+    template <class U, size_t M>
+    friend bool operator==(const SmallVec& left, const SmallVec<U, M>& right) {
+        return std::equal(left.begin(), left.end(), right.begin(), right.end());
+    }
+
+    template <class U, size_t M>
+    friend bool operator!=(const SmallVec& left, const SmallVec<U, M>& right) {
+        return !operator==(left, right);
+    }
+
+private:
+    void steal(SmallVec&& other) {
+        if (other.heap != nullptr) {
+            heap = other.heap;
+            capacity_ = other.capacity_;
+        } else {
+            detail::relocate(other.data(), other.size_, data());
+        }
+        size_ = other.size_;
+        other.heap = nullptr;
+        other.size_ = 0;
+        other.capacity_ = CAPACITY;
+    }
+
+    /// Adds an item constructed from the supplied arguments to the end of this full vector.
+    ///
+    /// The item is constructed in the new memory before the items are relocated to it since the
+    /// arguments may refer to items in this vector.
+    template <class... N>
+    T& emplace_back_slow(N&&... arguments) {
+        auto capacity = capacity_ * 2;
+        auto data = detail::allocate<T>(capacity);
+        T* item;
+        try {
+            item = new(data + size_) T(std::forward<N>(arguments)...);
+        } catch (...) {
+            std::free(data);
+            throw;
+        }
+        detail::relocate(this->data(), size_, data);
+        std::free(heap);
+
+        heap = data;
+        size_ += 1;
+        capacity_ = capacity;
+        return *item;
+    }
+
+    void grow() {
+        reallocate(capacity_ * 2);
+    }
+
+    void reallocate(size_t capacity) {
+        auto bytes = detail::bytes<T>(capacity);
+
+        T* data;
+        if (is_relocatable<T>() && heap != nullptr) {
+            data = static_cast<T*>(std::realloc(static_cast<void*>(heap), bytes));
+            if (data == nullptr) {
+                throw std::bad_alloc{};
+            }
+        } else {
+            data = detail::allocate<T>(capacity);
+            detail::relocate(this->data(), size_, data);
+            std::free(heap);
+        }
+
+        heap = data;
+        capacity_ = capacity;
+    }
+
+    void destroy() {
+        clear();
+        std::free(heap);
+        heap = nullptr;
+        capacity_ = CAPACITY;
+    }
+};
+
+}
+
+#endif
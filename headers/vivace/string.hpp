@@ -0,0 +1,321 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_STRING_HPP
+#define VCE_STRING_HPP
+
+#include <vivace/iterator.hpp>
+
+#include <cstring>
+#include <string_view>
+
+namespace vce {
+
+namespace detail {
+    /// Returns the position of the last of the supplied characters which is equal to the supplied
+    /// character or the supplied size if there is no such character.
+    inline size_t rfind(const char* data, size_t size, char value) {
+        if (size == 0) {
+            return 0;
+        }
+        auto found = ::memrchr(data, static_cast<unsigned char>(value), size);
+        return found ? static_cast<const char*>(found) - data : size;
+    }
+
+    /// Returns the position of the first of the supplied characters which is (or is not) ASCII
+    /// whitespace or the supplied size if there is no such character.
+    size_t find_whitespace(const char* data, size_t size, bool whitespace);
+
+    /// Returns the position of the last of the supplied characters which is (or is not) ASCII
+    /// whitespace or the supplied size if there is no such character.
+    size_t rfind_whitespace(const char* data, size_t size, bool whitespace);
+}
+
+/// An iterator over the substrings of a string separated by a character.
+class SplitIterator : public Iterator<std::string_view, SplitIterator> {
+    std::string_view rest;
+    char delimiter;
+    bool finished;
+
+protected:
+    Bounds bounds_impl() const {
+        if (finished) {
+            return {0, 0};
+        } else {
+            return {1, rest.size() + 1};
+        }
+    }
+
+    Option<std::string_view> next_impl() {
+        if (finished) {
+            return {};
+        }
+        auto position = detail::find(rest.data(), rest.size(), delimiter);
+        if (position == rest.size()) {
+            finished = true;
+            return {rest};
+        }
+        auto item = rest.substr(0, position);
+        rest.remove_prefix(position + 1);
+        return {item};
+    }
+
+    Option<std::string_view> next_back_impl() {
+        if (finished) {
+            return {};
+        }
+        auto position = detail::rfind(rest.data(), rest.size(), delimiter);
+        if (position == rest.size()) {
+            finished = true;
+            return {rest};
+        }
+        auto item = rest.substr(position + 1);
+        rest.remove_suffix(rest.size() - position);
+        return {item};
+    }
+
+public:
+    /// Constructs an iterator over the substrings of the supplied string separated by the supplied
+    /// character.
+    SplitIterator(std::string_view string, char delimiter)
+        : rest{string}, delimiter{delimiter}, finished{false} { }
+};
+
+/// An iterator over the substrings of a string separated by a string.
+class SplitStrIterator : public Iterator<std::string_view, SplitStrIterator> {
+    std::string_view rest;
+    std::string_view delimiter;
+    /// Whether a suffix of the delimiter is also a prefix of it, in which case occurrences of the
+    /// delimiter may overlap and the last occurrence isn't necessarily a separator.
+    bool overlapping;
+    bool finished;
+
+    /// Returns whether occurrences of the supplied delimiter may overlap.
+    static bool overlaps(std::string_view delimiter) {
+        for (size_t shift = 1; shift < delimiter.size(); ++shift) {
+            if (delimiter.substr(shift) == delimiter.substr(0, delimiter.size() - shift)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Returns the index of the last delimiter found when splitting from the front.
+    size_t find_back() const {
+        if (!overlapping) {
+            return rest.rfind(delimiter);
+        }
+        auto position = rest.npos;
+        auto start = size_t{0};
+        while (true) {
+            auto size = rest.size() - start;
+            auto data = rest.data() + start;
+            auto found = detail::search(data, size, delimiter.data(), delimiter.size());
+            if (found == size) {
+                return position;
+            }
+            position = start + found;
+            start = position + delimiter.size();
+        }
+    }
+
+protected:
+    Bounds bounds_impl() const {
+        if (finished) {
+            return {0, 0};
+        } else if (delimiter.empty()) {
+            return {1, 1};
+        } else {
+            return {1, rest.size() / delimiter.size() + 1};
+        }
+    }
+
+    Option<std::string_view> next_impl() {
+        if (finished) {
+            return {};
+        }
+        auto position = rest.size();
+        if (!delimiter.empty()) {
+            position = detail::search(rest.data(), rest.size(), delimiter.data(), delimiter.size());
+        }
+        if (position == rest.size()) {
+            finished = true;
+            return {rest};
+        }
+        auto item = rest.substr(0, position);
+        rest.remove_prefix(position + delimiter.size());
+        return {item};
+    }
+
+    Option<std::string_view> next_back_impl() {
+        if (finished) {
+            return {};
+        }
+        auto position = delimiter.empty() ? rest.npos : find_back();
+        if (position == rest.npos) {
+            finished = true;
+            return {rest};
+        }
+        auto item = rest.substr(position + delimiter.size());
+        rest.remove_suffix(rest.size() - position);
+        return {item};
+    }
+
+public:
+    /// Constructs an iterator over the substrings of the supplied string separated by the supplied
+    /// delimiter.
+    ///
+    /// An empty delimiter never matches so the string is emitted whole.
+    SplitStrIterator(std::string_view string, std::string_view delimiter)
+        : rest{string}, delimiter{delimiter}, overlapping{overlaps(delimiter)}, finished{false} { }
+};
+
+/// An iterator over the lines in a string.
+class LinesIterator : public Iterator<std::string_view, LinesIterator> {
+    std::string_view rest;
+    bool finished;
+
+    /// Removes the carriage return from the end of the supplied line, if any.
+    static std::string_view strip(std::string_view line) {
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        return line;
+    }
+
+protected:
+    Bounds bounds_impl() const {
+        if (finished) {
+            return {0, 0};
+        } else {
+            return {1, rest.size() + 1};
+        }
+    }
+
+    Option<std::string_view> next_impl() {
+        if (finished) {
+            return {};
+        }
+        auto position = detail::find(rest.data(), rest.size(), '\n');
+        if (position == rest.size()) {
+            finished = true;
+            return {rest};
+        }
+        auto item = strip(rest.substr(0, position));
+        rest.remove_prefix(position + 1);
+        return {item};
+    }
+
+    Option<std::string_view> next_back_impl() {
+        if (finished) {
+            return {};
+        }
+        auto position = detail::rfind(rest.data(), rest.size(), '\n');
+        if (position == rest.size()) {
+            finished = true;
+            return {rest};
+        }
+        auto item = rest.substr(position + 1);
+        rest = strip(rest.substr(0, position));
+        return {item};
+    }
+
+public:
+    /// Constructs an iterator over the lines in the supplied string.
+    LinesIterator(std::string_view string) : rest{string}, finished{string.empty()} {
+        if (!rest.empty() && rest.back() == '\n') {
+            rest = strip(rest.substr(0, rest.size() - 1));
+        }
+    }
+};
+
+/// An iterator over the substrings of a string separated by ASCII whitespace.
+class SplitWhitespaceIterator : public Iterator<std::string_view, SplitWhitespaceIterator> {
+    std::string_view rest;
+
+protected:
+    Bounds bounds_impl() const {
+        return {0, (rest.size() + 1) / 2};
+    }
+
+    Option<std::string_view> next_impl() {
+        auto start = detail::find_whitespace(rest.data(), rest.size(), false);
+        if (start == rest.size()) {
+            rest = {};
+            return {};
+        }
+        rest.remove_prefix(start);
+        auto end = detail::find_whitespace(rest.data(), rest.size(), true);
+        auto item = rest.substr(0, end);
+        rest.remove_prefix(end);
+        return {item};
+    }
+
+    Option<std::string_view> next_back_impl() {
+        auto end = detail::rfind_whitespace(rest.data(), rest.size(), false);
+        if (end == rest.size()) {
+            rest = {};
+            return {};
+        }
+        rest.remove_suffix(rest.size() - end - 1);
+        auto start = detail::rfind_whitespace(rest.data(), rest.size(), true);
+        start = start == rest.size() ? 0 : start + 1;
+        auto item = rest.substr(start);
+        rest.remove_suffix(item.size());
+        return {item};
+    }
+
+public:
+    /// Constructs an iterator over the substrings of the supplied string separated by ASCII
+    /// whitespace.
+    SplitWhitespaceIterator(std::string_view string) : rest{string} { }
+};
+
+/// Returns an iterator over the substrings of the supplied string separated by the supplied
+/// character.
+///
+/// Adjacent delimiters and delimiters at either end of the string produce empty substrings.
+inline SplitIterator split(std::string_view string, char delimiter) {
+    return {string, delimiter};
+}
+
+/// Returns an iterator over the substrings of the supplied string separated by the supplied
+/// delimiter.
+///
+/// Adjacent delimiters and delimiters at either end of the string produce empty substrings.
+/// Delimiters are matched from the front of the string in both directions so occurrences which
+/// overlap a match, such as the second `aa` in `aaa`, are not separators. Splitting from the back
+/// with such a delimiter scans the rest of the string from the front for each substring.
+inline SplitStrIterator split_str(std::string_view string, std::string_view delimiter) {
+    return {string, delimiter};
+}
+
+/// Returns an iterator over the lines in the supplied string.
+///
+/// Lines are terminated by `\n` or `\r\n` which are not included in the lines. The terminator of
+/// the last line is optional.
+inline LinesIterator lines(std::string_view string) {
+    return {string};
+}
+
+/// Returns an iterator over the non-empty substrings of the supplied string separated by runs of
+/// ASCII whitespace.
+inline SplitWhitespaceIterator split_whitespace(std::string_view string) {
+    return {string};
+}
+
+}
+
+#endif
@@ -0,0 +1,352 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_THREAD_POOL_HPP
+#define VCE_THREAD_POOL_HPP
+
+#include <vivace/option.hpp>
+#include <vivace/result.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace vce {
+
+/// An error which occurred while running a task, which is an exception thrown by the task.
+class TaskError {
+    std::exception_ptr exception_;
+
+public:
+    /// Constructs an error for the supplied exception thrown by a task.
+    explicit TaskError(std::exception_ptr exception) : exception_{std::move(exception)} { }
+
+    /// Returns the exception thrown by the task.
+    const std::exception_ptr& exception() const {
+        return exception_;
+    }
+
+    /// Returns the message of the exception thrown by the task if it is a standard exception.
+    std::string message() const;
+
+    /// Throws the exception thrown by the task.
+    [[noreturn]] void rethrow() const {
+        std::rethrow_exception(exception_);
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const TaskError& error);
+};
+
+class ThreadPool;
+
+namespace detail {
+    /// The type of the values returned by tasks which run the supplied function.
+    template <class F, class... A>
+    using TaskValue = std::conditional_t<
+        std::is_void_v<std::invoke_result_t<F&, A...>>, Unit, std::invoke_result_t<F&, A...>>;
+
+    /// Runs the supplied function and returns its value or the exception it threw.
+    template <class F, class... A>
+    Result<TaskValue<F, A...>, TaskError> run_task(F& f, A&&... arguments) {
+        try {
+            if constexpr (std::is_void_v<std::invoke_result_t<F&, A...>>) {
+                std::invoke(f, std::forward<A>(arguments)...);
+                return {OK, Unit{}};
+            } else {
+                return {OK, std::invoke(f, std::forward<A>(arguments)...)};
+            }
+        } catch (...) {
+            return {ERR, TaskError{std::current_exception()}};
+        }
+    }
+
+    /// A unit of work queued in a thread pool.
+    struct Job {
+        virtual ~Job() = default;
+
+        /// Runs this job and releases it, which must not throw.
+        virtual void run() = 0;
+    };
+
+    /// A counter of unfinished tasks which can be waited on.
+    class TaskLatch {
+        std::atomic<size_t> pending;
+        std::mutex mutex;
+        std::condition_variable finished;
+
+    public:
+        explicit TaskLatch(size_t pending) : pending{pending} { }
+
+        /// Returns whether every task has finished.
+        bool done() const {
+            return pending.load(std::memory_order_acquire) == 0;
+        }
+
+        /// Adds a task.
+        void add() {
+            pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// Marks a task as finished.
+        void count_down() {
+            // The lock keeps the latch alive until the waiters are notified.
+            std::lock_guard<std::mutex> lock{mutex};
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                finished.notify_all();
+            }
+        }
+
+        /// Blocks until every task has finished.
+        void wait() {
+            std::unique_lock<std::mutex> lock{mutex};
+            finished.wait(lock, [&] { return done(); });
+        }
+    };
+
+    template <class T>
+    struct TaskState {
+        TaskLatch latch{1};
+        Option<Result<T, TaskError>> result;
+    };
+
+    template <class F, class T>
+    struct TaskJob : Job {
+        F f;
+        std::shared_ptr<TaskState<T>> state;
+
+        TaskJob(F f, std::shared_ptr<TaskState<T>> state)
+            : f{std::move(f)}, state{std::move(state)} { }
+
+        void run() override {
+            auto result = run_task(f);
+            auto state = std::move(this->state);
+            delete this;
+            state->result = Option<Result<T, TaskError>>{std::move(result)};
+            state->latch.count_down();
+        }
+    };
+
+    /// A job which runs the second function of a join and lives on the stack of the join.
+    template <class F>
+    struct JoinJob : Job {
+        F& f;
+        TaskLatch latch{1};
+        Option<Result<TaskValue<F>, TaskError>> result;
+
+        explicit JoinJob(F& f) : f{f} { }
+
+        void run() override {
+            result = Option<Result<TaskValue<F>, TaskError>>{run_task(f)};
+            latch.count_down();
+        }
+    };
+}
+
+/// A handle to a task running in a thread pool which is used to wait for the value it returns.
+///
+/// Dropping a handle detaches the task which still runs to completion.
+template <class T>
+class TaskHandle {
+    ThreadPool* pool;
+    std::shared_ptr<detail::TaskState<T>> state;
+
+public:
+    TaskHandle(ThreadPool& pool, std::shared_ptr<detail::TaskState<T>> state)
+        : pool{&pool}, state{std::move(state)} { }
+
+    /// Returns whether the task has finished.
+    bool is_finished() const {
+        return state && state->latch.done();
+    }
+
+    /// Waits for the task to finish and returns the value it returned or the exception it threw.
+    ///
+    /// A worker thread of the pool runs other tasks while it waits. Panics if the task has already
+    /// been joined.
+    Result<T, TaskError> join();
+};
+
+/// A scope in which tasks which borrow from the stack of the thread that created it are spawned.
+///
+/// The scope doesn't end until every task spawned in it has finished.
+class Scope {
+    friend class ThreadPool;
+
+    template <class F>
+    struct ScopeJob : detail::Job {
+        F f;
+        Scope& scope;
+
+        ScopeJob(F f, Scope& scope) : f{std::move(f)}, scope{scope} { }
+
+        void run() override {
+            auto result = detail::run_task(f);
+            if (result.is_err()) {
+                scope.fail(result.unwrap_err());
+            }
+            // The function is destroyed before the scope can end.
+            auto& latch = scope.latch;
+            delete this;
+            latch.count_down();
+        }
+    };
+
+    ThreadPool& pool;
+    detail::TaskLatch latch;
+    std::mutex mutex;
+    Option<TaskError> error;
+
+    explicit Scope(ThreadPool& pool) : pool{pool}, latch{0} { }
+
+    /// Records the supplied error if it is the first error which occurred in this scope.
+    void fail(TaskError error) {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (this->error.is_none()) {
+            this->error = Option<TaskError>{std::move(error)};
+        }
+    }
+
+public:
+    Scope(const Scope& other) = delete;
+    Scope& operator=(const Scope& other) = delete;
+
+    /// Spawns a task which runs the supplied function.
+    template <class F>
+    void spawn(F f);
+};
+
+/// A pool of worker threads which run tasks with work stealing.
+///
+/// Each worker has its own deque of tasks. Tasks spawned by a worker are pushed onto the bottom of
+/// its deque and popped by it in last-in first-out order while idle workers steal the oldest tasks
+/// from the tops of the deques of other workers. Tasks spawned by other threads are queued in a
+/// shared queue. Idle workers sleep until more tasks are spawned.
+class ThreadPool {
+    struct State;
+
+    std::unique_ptr<State> state;
+
+    void submit(detail::Job* job);
+
+    /// Waits for the tasks counted by the supplied latch to finish, running other tasks meanwhile
+    /// if this is a worker thread of this pool.
+    void wait(detail::TaskLatch& latch);
+
+    template <class T>
+    friend class TaskHandle;
+
+    friend class Scope;
+
+public:
+    /// Whether worker threads are pinned to processors.
+    enum class Affinity {
+        /// Workers may run on any processor.
+        None,
+        /// Each worker runs on one of the processors the process may run on, in turn.
+        Pinned,
+    };
+
+    /// Constructs a pool with the supplied number of worker threads.
+    ///
+    /// Panics if the number of threads is zero.
+    explicit ThreadPool(size_t threads, Affinity affinity = Affinity::None);
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    /// Runs the remaining tasks and then stops the worker threads.
+    ~ThreadPool();
+
+    /// Returns the process-wide pool which has a worker thread for each hardware thread.
+    static ThreadPool& global();
+
+    /// Returns the number of worker threads in this pool.
+    size_t threads() const;
+
+    /// Spawns a task which runs the supplied function and returns a handle to it.
+    ///
+    /// The task may outlive the calling scope so the function must own everything it uses.
+    /// Functions which borrow from the stack are spawned in a scope instead.
+    template <class F>
+    TaskHandle<detail::TaskValue<F>> spawn(F f) {
+        using T = detail::TaskValue<F>;
+        auto state = std::make_shared<detail::TaskState<T>>();
+        submit(new detail::TaskJob<F, T>{std::move(f), state});
+        return {*this, std::move(state)};
+    }
+
+    /// Calls the supplied function with a scope in which it may spawn tasks and waits for them.
+    ///
+    /// Returns the value returned by the function or the first exception thrown by the function or
+    /// the tasks spawned in the scope.
+    template <class F>
+    Result<detail::TaskValue<F, Scope&>, TaskError> scope(F f) {
+        Scope scope{*this};
+        auto result = detail::run_task(f, scope);
+        wait(scope.latch);
+        if (scope.error.is_some() && result.is_ok()) {
+            return {ERR, scope.error.unwrap()};
+        }
+        return result;
+    }
+
+    /// Runs the supplied functions, possibly in parallel, and returns the values they returned.
+    ///
+    /// The second function is spawned while the first is run by the calling thread, so functions
+    /// may borrow from the stack and recursive joins divide work among the workers. Returns the
+    /// first exception thrown by either function.
+    template <class A, class B>
+    Result<std::pair<detail::TaskValue<A>, detail::TaskValue<B>>, TaskError> join(A a, B b) {
+        detail::JoinJob<B> job{b};
+        submit(&job);
+        auto first = detail::run_task(a);
+        wait(job.latch);
+        auto second = job.result.unwrap();
+        if (first.is_err()) {
+            return {ERR, first.unwrap_err()};
+        } else if (second.is_err()) {
+            return {ERR, second.unwrap_err()};
+        }
+        return {OK, std::make_pair(first.unwrap(), second.unwrap())};
+    }
+};
+
+template <class T>
+Result<T, TaskError> TaskHandle<T>::join() {
+    if (!state) {
+        detail::panic("attempted to join a task twice");
+    }
+    pool->wait(state->latch);
+    auto result = state->result.unwrap();
+    state.reset();
+    return result;
+}
+
+template <class F>
+void Scope::spawn(F f) {
+    latch.add();
+    pool.submit(new ScopeJob<F>{std::move(f), *this});
+}
+
+}
+
+#endif
@@ -21,8 +21,22 @@
 
 #include <vivace/meta.hpp>
 
+/// Hints that the supplied condition is likely to be true.
+#define VCE_LIKELY(...) __builtin_expect(!!(__VA_ARGS__), 1)
+
+/// Hints that the supplied condition is unlikely to be true.
+#define VCE_UNLIKELY(...) __builtin_expect(!!(__VA_ARGS__), 0)
+
+/// Marks a function as rarely called so that it is kept out of line and away from hot code.
+#define VCE_COLD __attribute__((cold, noinline))
+
 namespace vce {
 
+namespace detail {
+    /// Throws a logic error with the supplied message.
+    [[noreturn]] VCE_COLD void panic(const char* message);
+}
+
 /// An ordering of two values.
 enum class Ordering : int {
     Less = -1,
@@ -100,6 +114,80 @@ using Ref = std::reference_wrapper<T>;
 template <bool ENABLE>
 using Sfinae = typename std::enable_if_t<ENABLE, int>;
 
+namespace detail {
+    template <class T, class C, class = void>
+    struct IsSpanConstructible : std::false_type { };
+
+    template <class T, class C>
+    struct IsSpanConstructible<T, C, std::void_t<decltype(std::declval<C&>().data())>> :
+        std::is_convertible<decltype(std::declval<C&>().data()), T*> { };
+
+    template <class T, class C>
+    static constexpr bool IsSpanConstructibleV = IsSpanConstructible<T, C>::value;
+}
+
+/// A non-owning view of a contiguous sequence of values.
+template <class T>
+class Span {
+    T* data_;
+    size_t size_;
+
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+    using const_iterator = T*;
+
+    /// Constructs an empty view.
+    constexpr Span() : data_{nullptr}, size_{0} { }
+
+    /// Constructs a view of the supplied number of values starting at the supplied address.
+    constexpr Span(T* data, size_t size) : data_{data}, size_{size} { }
+
+    /// Constructs a view of the values in the supplied array.
+    template <size_t N>
+    constexpr Span(T (&array)[N]) : data_{array}, size_{N} { }
+
+    /// Constructs a view of the values in the supplied contiguous container.
+    template <class C, Sfinae<detail::IsSpanConstructibleV<T, C>> = 0>
+    constexpr Span(C& container) : data_{container.data()}, size_{container.size()} { }
+
+    /// Constructs a view of the values in the supplied view.
+    template <class U, Sfinae<std::is_convertible_v<U*, T*>> = 0>
+    constexpr Span(Span<U> other) : data_{other.data()}, size_{other.size()} { }
+
+    /// Returns a pointer to the values in this view.
+    constexpr T* data() const {
+        return data_;
+    }
+
+    /// Returns the number of values in this view.
+    constexpr size_t size() const {
+        return size_;
+    }
+
+    /// Returns whether this view contains no values.
+    constexpr bool empty() const {
+        return size_ == 0;
+    }
+
+    /// Returns a view of the supplied number of values starting at the supplied offset.
+    constexpr Span subspan(size_t offset, size_t size) const {
+        return {data_ + offset, size};
+    }
+
+    constexpr T& operator[](size_t index) const {
+        return data_[index];
+    }
+
+    constexpr T* begin() const {
+        return data_;
+    }
+
+    constexpr T* end() const {
+        return data_ + size_;
+    }
+};
+
 /// The unit type.
 struct Unit { };
 
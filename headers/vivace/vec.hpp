@@ -0,0 +1,370 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef VCE_VEC_HPP
+#define VCE_VEC_HPP
+
+#include <vivace/math.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+
+namespace vce {
+
+namespace detail {
+    /// Moves the supplied items into uninitialized memory and destroys the originals.
+    template <class T>
+    void relocate(T* from, size_t size, T* to) {
+        if constexpr (is_relocatable<T>()) {
+            if (size != 0) {
+                std::memcpy(static_cast<void*>(to), from, size * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < size; ++i) {
+                new(to + i) T(std::move(from[i]));
+                from[i].~T();
+            }
+        }
+    }
+
+    /// Inserts the supplied item into an array with room for at least one more item.
+    template <class T>
+    void insert(T* data, size_t size, size_t index, T&& item) {
+        auto slot = data + index;
+        if constexpr (is_relocatable<T>()) {
+            std::memmove(static_cast<void*>(slot + 1), slot, (size - index) * sizeof(T));
+            try {
+                new(slot) T(std::move(item));
+            } catch (...) {
+                std::memmove(static_cast<void*>(slot), slot + 1, (size - index) * sizeof(T));
+                throw;
+            }
+        } else if (index == size) {
+            new(slot) T(std::move(item));
+        } else {
+            new(data + size) T(std::move(data[size - 1]));
+            std::move_backward(slot, data + size - 1, data + size);
+            *slot = std::move(item);
+        }
+    }
+
+    /// Removes an item from an array.
+    template <class T>
+    void erase(T* data, size_t size, size_t index) {
+        auto slot = data + index;
+        if constexpr (is_relocatable<T>()) {
+            slot->~T();
+            std::memmove(static_cast<void*>(slot), slot + 1, (size - index - 1) * sizeof(T));
+        } else {
+            std::move(slot + 1, data + size, slot);
+            data[size - 1].~T();
+        }
+    }
+
+    /// Destroys the supplied items.
+    template <class T>
+    void destroy(T* data, size_t size) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < size; ++i) {
+                data[i].~T();
+            }
+        }
+    }
+
+    /// Copies the supplied items into uninitialized memory.
+    template <class T>
+    void copy(const T* from, size_t size, T* to) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (size != 0) {
+                std::memcpy(static_cast<void*>(to), from, size * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < size; ++i) {
+                new(to + i) T(from[i]);
+            }
+        }
+    }
+
+    /// Returns the number of bytes occupied by the supplied number of items.
+    template <class T>
+    size_t bytes(size_t size) {
+        return checked_mul(size, sizeof(T)).unwrap_or_else([]() -> size_t {
+            throw std::bad_alloc{};
+        });
+    }
+
+    /// Allocates uninitialized memory for the supplied number of items.
+    template <class T>
+    T* allocate(size_t capacity) {
+        auto data = static_cast<T*>(std::malloc(bytes<T>(capacity)));
+        if (data == nullptr) {
+            throw std::bad_alloc{};
+        }
+        return data;
+    }
+}
+
+/// A growable array which relocates its items with `memcpy` and `realloc` when they are
+/// relocatable.
+template <class T>
+class Vec {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned items are not supported");
+
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /// Whether this type may be safely moved to another location in memory.
+    static constexpr bool RELOCATABLE = true;
+
+    /// Constructs an empty vector.
+    constexpr Vec() : data_{nullptr}, size_{0}, capacity_{0} { }
+
+    /// Constructs a vector containing the supplied items.
+    Vec(std::initializer_list<T> list) : Vec{} {
+        reserve(list.size());
+        detail::copy(list.begin(), list.size(), data_);
+        size_ = list.size();
+    }
+
+    Vec(const Vec& other) : Vec{} {
+        reserve(other.size_);
+        copy(other);
+    }
+
+    Vec& operator=(const Vec& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            copy(other);
+        }
+        return *this;
+    }
+
+    Vec(Vec&& other) noexcept
+        : data_{other.data_}, size_{other.size_}, capacity_{other.capacity_} {
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    Vec& operator=(Vec&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    ~Vec() {
+        destroy();
+    }
+
+    /// Returns the number of items in this vector.
+    size_t size() const {
+        return size_;
+    }
+
+    /// Returns the number of items this vector can contain without reallocating.
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    /// Returns whether this vector contains no items.
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /// Returns a pointer to the items in this vector.
+    T* data() {
+        return data_;
+    }
+
+    /// Returns a pointer to the items in this vector.
+    const T* data() const {
+        return data_;
+    }
+
+    T& operator[](size_t index) {
+        return data_[index];
+    }
+
+    const T& operator[](size_t index) const {
+        return data_[index];
+    }
+
+    T* begin() {
+        return data_;
+    }
+
+    const T* begin() const {
+        return data_;
+    }
+
+    T* end() {
+        return data_ + size_;
+    }
+
+    const T* end() const {
+        return data_ + size_;
+    }
+
+    /// Ensures this vector can contain at least the supplied number of items without reallocating.
+    void reserve(size_t capacity) {
+        if (capacity > capacity_) {
+            reallocate(capacity);
+        }
+    }
+
+    /// Adds the supplied item to the end of this vector.
+    void push_back(T item) {
+        emplace_back(std::move(item));
+    }
+
+    /// Adds an item constructed from the supplied arguments to the end of this vector.
+    template <class... N>
+    T& emplace_back(N&&... arguments) {
+        if (VCE_UNLIKELY(size_ == capacity_)) {
+            return emplace_back_slow(std::forward<N>(arguments)...);
+        }
+        auto item = new(data_ + size_) T(std::forward<N>(arguments)...);
+        size_ += 1;
+        return *item;
+    }
+
+    /// Removes and returns the item at the end of this vector, if any.
+    Option<T> pop_back() {
+        if (size_ != 0) {
+            size_ -= 1;
+            Option<T> item{std::move(data_[size_])};
+            data_[size_].~T();
+            return item;
+        } else {
+            return {};
+        }
+    }
+
+    /// Inserts the supplied item at the supplied index, shifting the items after it to the right.
+    void insert(size_t index, T item) {
+        if (size_ == capacity_) {
+            grow();
+        }
+        detail::insert(data_, size_, index, std::move(item));
+        size_ += 1;
+    }
+
+    /// Removes the item at the supplied index, shifting the items after it to the left.
+    void erase(size_t index) {
+        detail::erase(data_, size_, index);
+        size_ -= 1;
+    }
+
+    /// Removes all of the items in this vector without releasing its memory.
+    void clear() {
+        detail::destroy(data_, size_);
+        size_ = 0;
+    }
+
+    template <class U>
+    friend bool operator==(const Vec& left, const Vec<U>& right) {
+        return std::equal(left.begin(), left.end(), right.begin(), right.end());
+    }
+
+    template <class U>
+    friend bool operator!=(const Vec& left, const Vec<U>& right) {
+        return !operator==(left, right);
+    }
+
+private:
+    void copy(const Vec& other) {
+        detail::copy(other.data_, other.size_, data_);
+        size_ = other.size_;
+    }
+
+    /// Adds an item constructed from the supplied arguments to the end of this full vector.
+    ///
+    /// The item is constructed in the new memory before the items are relocated to it since the
+    /// arguments may refer to items in this vector.
+    template <class... N>
+    T& emplace_back_slow(N&&... arguments) {
+        auto capacity = capacity_ != 0 ? capacity_ * 2 : 4;
+        auto data = detail::allocate<T>(capacity);
+        T* item;
+        try {
+            item = new(data + size_) T(std::forward<N>(arguments)...);
+        } catch (...) {
+            std::free(data);
+            throw;
+        }
+        detail::relocate(data_, size_, data);
+        std::free(data_);
+
+        data_ = data;
+        size_ += 1;
+        capacity_ = capacity;
+        return *item;
+    }
+
+    void grow() {
+        reallocate(capacity_ != 0 ? capacity_ * 2 : 4);
+    }
+
+    void reallocate(size_t capacity) {
+        auto bytes = detail::bytes<T>(capacity);
+
+        T* data;
+        if constexpr (is_relocatable<T>()) {
+            data = static_cast<T*>(std::realloc(static_cast<void*>(data_), bytes));
+            if (data == nullptr) {
+                throw std::bad_alloc{};
+            }
+        } else {
+            data = detail::allocate<T>(capacity);
+            detail::relocate(data_, size_, data);
+            std::free(data_);
+        }
+
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    void destroy() {
+        clear();
+        std::free(data_);
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vivace/arena.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace vce {
+
+/// A chunk of memory backing an arena.
+struct Arena::Chunk {
+    /// The next chunk in the arena, if any.
+    Chunk* next;
+    /// The number of bytes in this chunk after the header.
+    size_t size;
+
+    char* begin() {
+        return reinterpret_cast<char*>(this + 1);
+    }
+
+    char* end() {
+        return begin() + size;
+    }
+};
+
+Arena::~Arena() {
+    while (first != nullptr) {
+        auto next = first->next;
+        std::free(first);
+        first = next;
+    }
+}
+
+void Arena::enter(Chunk* chunk) {
+    current = chunk;
+    pointer = chunk->begin();
+    end = chunk->end();
+}
+
+void* Arena::allocate_slow(size_t size, size_t alignment) {
+    // Chunks which were retained when this arena was reset or rewound are reused if they are large
+    // enough and otherwise a new chunk is inserted after the current chunk.
+    if (size > Limits<size_t>::max() - alignment - sizeof(Chunk)) {
+        throw std::bad_alloc{};
+    }
+
+    auto required = size + alignment;
+    if (current != nullptr && current->next != nullptr && current->next->size >= required) {
+        enter(current->next);
+    } else {
+        auto chunk_size = std::max(next_size, required);
+        auto chunk = static_cast<Chunk*>(std::malloc(sizeof(Chunk) + chunk_size));
+        if (chunk == nullptr) {
+            throw std::bad_alloc{};
+        }
+        chunk->size = chunk_size;
+        capacity_ += chunk_size;
+        if (chunk_size == next_size) {
+            next_size *= 2;
+        }
+
+        if (current != nullptr) {
+            chunk->next = current->next;
+            current->next = chunk;
+        } else {
+            chunk->next = first;
+            first = chunk;
+        }
+        enter(chunk);
+    }
+    return allocate(size, alignment);
+}
+
+}
@@ -0,0 +1,182 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vivace/csv.hpp>
+#include <vivace/simd.hpp>
+
+namespace vce {
+
+namespace {
+    using S = detail::Simd<uint8_t>;
+
+    /// Returns the position of the first delimiter, newline or quote in the supplied text at or
+    /// after the supplied position or the size of the text if there is no such character.
+    size_t find_structural(std::string_view text, size_t position, char delimiter) {
+        auto bytes = reinterpret_cast<const uint8_t*>(text.data());
+        auto size = text.size();
+
+        auto delimiters = S::splat(static_cast<uint8_t>(delimiter));
+        auto newlines = S::splat('\n');
+        auto quotes = S::splat('"');
+        for (; position + S::LANES <= size; position += S::LANES) {
+            auto vector = S::load(bytes + position);
+            auto lanes = (vector == delimiters) | (vector == newlines) | (vector == quotes);
+            auto mask = detail::movemask((S::type)lanes);
+            if (mask != 0) {
+                return position + __builtin_ctz(mask);
+            }
+        }
+
+        for (; position < size; ++position) {
+            auto c = text[position];
+            if (c == delimiter || c == '\n' || c == '"') {
+                return position;
+            }
+        }
+        return size;
+    }
+
+    /// Removes the carriage return from the end of the supplied field, if any.
+    std::string_view strip(std::string_view field) {
+        if (!field.empty() && field.back() == '\r') {
+            field.remove_suffix(1);
+        }
+        return field;
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const CsvError& error) {
+    stream << "CsvError(";
+    switch (error.kind()) {
+    case CsvError::Kind::UnterminatedQuote:
+        stream << "unterminated quote";
+        break;
+    case CsvError::Kind::InvalidQuote:
+        stream << "invalid quote";
+        break;
+    case CsvError::Kind::Io:
+        stream << error.io().unwrap();
+        break;
+    }
+    return stream << " in row " << error.row() << ")";
+}
+
+detail::CsvParser::Step detail::CsvParser::parse(std::string_view text, bool last) {
+    constexpr Step INCOMPLETE{Status::Incomplete, 0, CsvError::Kind::Io};
+
+    fields.clear();
+    escaped.clear();
+
+    auto size = text.size();
+    size_t position = 0;
+    while (true) {
+        if (position < size && text[position] == '"') {
+            // Quotes inside a quoted field are either escaped by another quote or end the field.
+            auto start = position + 1;
+            auto end = start;
+            auto escapes = false;
+            while (true) {
+                end += detail::find(text.data() + end, size - end, '"');
+                if (end == size || (end + 1 == size && !last)) {
+                    if (!last) {
+                        return INCOMPLETE;
+                    }
+                    return {Status::Error, 0, CsvError::Kind::UnterminatedQuote};
+                } else if (end + 1 < size && text[end + 1] == '"') {
+                    escapes = true;
+                    end += 2;
+                } else {
+                    break;
+                }
+            }
+
+            if (escapes) {
+                escaped.push_back(fields.size());
+            }
+            fields.push_back(text.substr(start, end - start));
+
+            position = end + 1;
+            if (position == size) {
+                break;
+            }
+            auto c = text[position];
+            if (c == delimiter) {
+                position += 1;
+            } else if (c == '\n') {
+                position += 1;
+                break;
+            } else if (c == '\r' && position + 1 < size && text[position + 1] == '\n') {
+                position += 2;
+                break;
+            } else if (c == '\r' && position + 1 == size) {
+                if (!last) {
+                    return INCOMPLETE;
+                }
+                position += 1;
+                break;
+            } else {
+                return {Status::Error, 0, CsvError::Kind::InvalidQuote};
+            }
+        } else {
+            auto end = find_structural(text, position, delimiter);
+            if (end == size) {
+                if (!last) {
+                    return INCOMPLETE;
+                }
+                fields.push_back(strip(text.substr(position)));
+                position = size;
+                break;
+            }
+
+            auto c = text[end];
+            if (c == delimiter) {
+                fields.push_back(text.substr(position, end - position));
+                position = end + 1;
+            } else if (c == '\n') {
+                fields.push_back(strip(text.substr(position, end - position)));
+                position = end + 1;
+                break;
+            } else {
+                return {Status::Error, 0, CsvError::Kind::InvalidQuote};
+            }
+        }
+    }
+
+    if (!escaped.empty()) {
+        unescape();
+    }
+    return {Status::Row, position, CsvError::Kind::Io};
+}
+
+void detail::CsvParser::unescape() {
+    size_t size = 0;
+    for (auto index : escaped) {
+        size += fields[index].size();
+    }
+    scratch.resize(size);
+
+    // The unescaped fields are no longer than the escaped fields so they fit in the buffer.
+    auto output = &scratch[0];
+    for (auto index : escaped) {
+        auto field = fields[index];
+        auto start = output;
+        for (size_t i = 0; i < field.size(); ++i) {
+            *output++ = field[i];
+            i += field[i] == '"' ? 1 : 0;
+        }
+        fields[index] = {start, static_cast<size_t>(output - start)};
+    }
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <vivace/hash.hpp>
+
+namespace vce {
+
+namespace {
+    uint64_t read8(const uint8_t* bytes) {
+        uint64_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint64_t read4(const uint8_t* bytes) {
+        uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint64_t read3(const uint8_t* bytes, size_t size) {
+        return (uint64_t{bytes[0]} << 16) | (uint64_t{bytes[size >> 1]} << 8) | bytes[size - 1];
+    }
+}
+
+void Hasher::write(const void* bytes, size_t size) {
+    using detail::mix;
+    using detail::SECRET;
+
+    auto p = static_cast<const uint8_t*>(bytes);
+    auto seed = state;
+
+    uint64_t a;
+    uint64_t b;
+    if (size <= 16) {
+        if (size >= 4) {
+            auto offset = (size >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + offset);
+            b = (read4(p + size - 4) << 32) | read4(p + size - 4 - offset);
+        } else if (size > 0) {
+            a = read3(p, size);
+            b = 0;
+        } else {
+            a = 0;
+            b = 0;
+        }
+    } else {
+        auto remaining = size;
+        if (remaining > 48) {
+            auto first = seed;
+            auto second = seed;
+            do {
+                seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+                first = mix(read8(p + 16) ^ SECRET[2], read8(p + 24) ^ first);
+                second = mix(read8(p + 32) ^ SECRET[3], read8(p + 40) ^ second);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= first ^ second;
+        }
+        while (remaining > 16) {
+            seed = mix(read8(p) ^ SECRET[1], read8(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        a = read8(p + remaining - 16);
+        b = read8(p + remaining - 8);
+    }
+
+    __extension__ auto product = static_cast<unsigned __int128>(a ^ SECRET[1]) * (b ^ seed);
+    a = static_cast<uint64_t>(product);
+    b = static_cast<uint64_t>(product >> 64);
+    state = mix(a ^ SECRET[0] ^ size, b ^ SECRET[1]);
+}
+
+}
@@ -0,0 +1,359 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vivace/io.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace vce {
+
+/// The size of mappings above which huge pages are requested.
+static constexpr size_t HUGE_PAGE_THRESHOLD = 2 * 1024 * 1024;
+
+IoError IoError::last() {
+    return IoError{errno};
+}
+
+const char* IoError::message() const {
+    return std::strerror(code_);
+}
+
+Result<MappedFile, IoError> MappedFile::open(const char* path, Access access) {
+    auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return {ERR, IoError::last()};
+    }
+
+    struct stat status;
+    if (::fstat(fd, &status) != 0) {
+        auto error = IoError::last();
+        ::close(fd);
+        return {ERR, error};
+    } else if (S_ISDIR(status.st_mode)) {
+        ::close(fd);
+        return {ERR, IoError{EISDIR}};
+    }
+
+    // Empty files can't be mapped.
+    auto size = static_cast<size_t>(status.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return {OK, MappedFile{nullptr, 0}};
+    }
+
+    auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    auto error = IoError::last();
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return {ERR, error};
+    }
+
+    // The advice is only a hint so failures are ignored.
+    if (access == Access::Sequential) {
+        ::madvise(data, size, MADV_SEQUENTIAL);
+        ::madvise(data, size, MADV_WILLNEED);
+    } else {
+        ::madvise(data, size, MADV_RANDOM);
+    }
+#ifdef MADV_HUGEPAGE
+    if (size >= HUGE_PAGE_THRESHOLD) {
+        ::madvise(data, size, MADV_HUGEPAGE);
+    }
+#endif
+
+    return {OK, MappedFile{static_cast<const char*>(data), size}};
+}
+
+void MappedFile::unmap() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+/// A buffer shared by the background thread and the consumer of a chunk iterator.
+struct Buffer {
+    std::byte* data;
+    size_t size;
+    int error;
+    bool filled;
+};
+
+struct ChunkIterator::State {
+    int fd;
+    size_t chunk_size;
+    std::unique_ptr<std::byte[]> memory;
+    Buffer buffers[2];
+    /// The index of the buffer the consumer reads next.
+    size_t current = 0;
+    /// Whether the consumer holds the current buffer.
+    bool held = false;
+    bool finished = false;
+    std::atomic<bool> stopped{false};
+    /// An event which is signaled to interrupt the background thread while it waits for data.
+    int wake;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread thread;
+
+    State(int fd, size_t chunk_size) : fd{fd}, chunk_size{chunk_size} {
+        memory.reset(new std::byte[2 * chunk_size]);
+        buffers[0] = {memory.get(), 0, 0, false};
+        buffers[1] = {memory.get() + chunk_size, 0, 0, false};
+        wake = ::eventfd(0, EFD_CLOEXEC);
+        if (wake == -1) {
+            // The error is emitted in place of the first chunk.
+            buffers[0] = {memory.get(), 0, errno, true};
+        } else {
+            thread = std::thread{[this] { read(); }};
+        }
+    }
+
+    ~State() {
+        if (wake != -1) {
+            ::close(wake);
+        }
+    }
+
+    /// Stops the background thread, interrupting a wait for data.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopped.store(true, std::memory_order_relaxed);
+        }
+        changed.notify_all();
+        if (thread.joinable()) {
+            uint64_t one = 1;
+            auto written = ::write(wake, &one, sizeof(one));
+            static_cast<void>(written);
+            thread.join();
+        }
+    }
+
+    /// Waits until data is available or the end of the file is reached and reads once into the
+    /// supplied buffer.
+    ///
+    /// Returns the number of bytes read, which is zero at the end of the file or once stopped, and
+    /// the error that stopped reading, if any.
+    std::pair<size_t, int> fill(std::byte* data) {
+        if (fd < 0) {
+            return {0, EBADF};
+        }
+        while (!stopped.load(std::memory_order_relaxed)) {
+            pollfd fds[2] = {{fd, POLLIN, 0}, {wake, POLLIN, 0}};
+            if (::poll(fds, 2, -1) == -1) {
+                if (errno != EINTR) {
+                    return {0, errno};
+                }
+                continue;
+            } else if (fds[1].revents != 0) {
+                break;
+            } else if (fds[0].revents & POLLNVAL) {
+                return {0, EBADF};
+            }
+
+            auto count = ::read(fd, data, chunk_size);
+            if (count >= 0) {
+                return {static_cast<size_t>(count), 0};
+            } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                return {0, errno};
+            }
+        }
+        return {0, 0};
+    }
+
+    /// Fills the buffers in turn until the end of the file or an error is reached.
+    void read() {
+        for (size_t i = 0; ; i ^= 1) {
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                changed.wait(lock, [&] { return stopped || !buffers[i].filled; });
+                if (stopped) {
+                    return;
+                }
+            }
+
+            auto [size, error] = fill(buffers[i].data);
+
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                buffers[i].size = size;
+                buffers[i].error = error;
+                buffers[i].filled = true;
+            }
+            changed.notify_all();
+
+            if (size == 0) {
+                return;
+            }
+        }
+    }
+};
+
+ChunkIterator::ChunkIterator(int fd, size_t chunk_size) {
+    if (chunk_size == 0) {
+        detail::panic("attempted to read chunks of zero bytes");
+    }
+    state.reset(new State{fd, chunk_size});
+}
+
+ChunkIterator::ChunkIterator(ChunkIterator&& other) = default;
+
+ChunkIterator& ChunkIterator::operator=(ChunkIterator&& other) {
+    if (this != &other) {
+        stop();
+        state = std::move(other.state);
+    }
+    return *this;
+}
+
+ChunkIterator::~ChunkIterator() {
+    stop();
+}
+
+Option<ChunkIterator::Chunk> ChunkIterator::next_impl() {
+    if (state->finished) {
+        return {};
+    }
+
+    std::unique_lock<std::mutex> lock{state->mutex};
+    if (state->held) {
+        state->buffers[state->current].filled = false;
+        state->current ^= 1;
+        state->held = false;
+        state->changed.notify_all();
+    }
+
+    auto& buffer = state->buffers[state->current];
+    state->changed.wait(lock, [&] { return buffer.filled; });
+    if (buffer.error != 0) {
+        state->finished = true;
+        return {Chunk{ERR, IoError{buffer.error}}};
+    } else if (buffer.size == 0) {
+        state->finished = true;
+        return {};
+    }
+
+    state->held = true;
+    return {Chunk{OK, Span<const std::byte>{buffer.data, buffer.size}}};
+}
+
+void ChunkIterator::stop() {
+    if (state) {
+        state->stop();
+        state.reset();
+    }
+}
+
+/// The minimum number of bytes which are written directly instead of being buffered when they
+/// don't fit in the rest of the buffer.
+static constexpr size_t DIRECT_THRESHOLD = 4096;
+
+Writer::Writer(int fd, size_t capacity)
+    : fd{fd}, capacity{capacity}, size{0}, written{0}, error{0} {
+    if (capacity == 0) {
+        detail::panic("attempted to buffer zero bytes");
+    }
+    buffer.reset(new char[capacity]);
+}
+
+Writer::~Writer() {
+    if (buffer) {
+        flush();
+    }
+}
+
+void Writer::append_slow(const char* data, size_t size) {
+    if (error != 0) {
+        return;
+    } else if (size >= DIRECT_THRESHOLD || size > capacity) {
+        write_buffer(data, size);
+    } else {
+        write_buffer(nullptr, 0);
+        std::memcpy(buffer.get(), data, size);
+        this->size = size;
+    }
+}
+
+void Writer::write_buffer(const char* data, size_t size) {
+    iovec vectors[2] = {{buffer.get(), this->size}, {const_cast<char*>(data), size}};
+    iovec* vector = vectors;
+    int count = size == 0 ? 1 : 2;
+    this->size = 0;
+    while (count != 0) {
+        if (vector->iov_len == 0) {
+            vector += 1;
+            count -= 1;
+            continue;
+        }
+
+        auto result = ::writev(fd, vector, count);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error = errno;
+            return;
+        } else if (result == 0) {
+            error = EIO;
+            return;
+        }
+
+        // A short write is continued from the first byte which was not written.
+        auto remaining = static_cast<size_t>(result);
+        written += remaining;
+        while (count != 0 && remaining >= vector->iov_len) {
+            remaining -= vector->iov_len;
+            vector += 1;
+            count -= 1;
+        }
+        if (count != 0) {
+            vector->iov_base = static_cast<char*>(vector->iov_base) + remaining;
+            vector->iov_len -= remaining;
+        }
+    }
+}
+
+Result<size_t, IoError> Writer::flush() {
+    if (error == 0 && size != 0) {
+        write_buffer(nullptr, 0);
+    }
+    if (error != 0) {
+        return {ERR, IoError{error}};
+    } else {
+        return {OK, written};
+    }
+}
+
+Result<MappedLinesIterator, IoError> mmap_lines(const char* path) {
+    return MappedFile::open(path).map([](auto file) {
+        return MappedLinesIterator{std::move(file)};
+    });
+}
+
+}
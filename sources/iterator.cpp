@@ -14,8 +14,46 @@
 
 #include <vivace/iterator.hpp>
 
+#include <cstring>
+
 namespace vce {
 
+size_t detail::mismatch(const void* left, const void* right, size_t size) {
+    auto l = static_cast<const unsigned char*>(left);
+    auto r = static_cast<const unsigned char*>(right);
+
+    // Equal blocks are skipped with memcmp which is vectorized by the C library and the first
+    // differing block is then searched one word at a time.
+    static constexpr size_t BLOCK = 256;
+
+    size_t offset = 0;
+    while (offset + BLOCK <= size && std::memcmp(l + offset, r + offset, BLOCK) == 0) {
+        offset += BLOCK;
+    }
+
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        uint64_t lword;
+        uint64_t rword;
+        std::memcpy(&lword, l + offset, sizeof(lword));
+        std::memcpy(&rword, r + offset, sizeof(rword));
+        if (lword != rword) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return offset + __builtin_clzll(lword ^ rword) / 8;
+#else
+            return offset + __builtin_ctzll(lword ^ rword) / 8;
+#endif
+        }
+    }
+
+    for (; offset < size; ++offset) {
+        if (l[offset] != r[offset]) {
+            return offset;
+        }
+    }
+
+    return size;
+}
+
 Bounds::Bounds(size_t lower) : lower{lower} { }
 
 Bounds::Bounds(size_t lower, size_t upper) : lower{lower}, upper{upper} { }
@@ -34,4 +72,9 @@ bool operator!=(Bounds left, Bounds right) {
     return !operator==(left, right);
 }
 
+void hash_combine(Hasher& hasher, Bounds bounds) {
+    hash_combine(hasher, bounds.lower);
+    hash_combine(hasher, bounds.upper);
+}
+
 }
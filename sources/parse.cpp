@@ -0,0 +1,33 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <vivace/parse.hpp>
+
+namespace vce {
+
+std::ostream& operator<<(std::ostream& stream, ParseError error) {
+    stream << "ParseError(";
+    switch (error.kind()) {
+    case ParseError::Kind::Empty:
+        return stream << "empty string)";
+    case ParseError::Kind::Invalid:
+        return stream << "invalid character at " << error.position() << ")";
+    case ParseError::Kind::OutOfRange:
+        return stream << "number out of range)";
+    }
+    return stream << "?)";
+}
+
+}
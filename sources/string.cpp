@@ -0,0 +1,75 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vivace/simd.hpp>
+#include <vivace/string.hpp>
+
+namespace vce {
+
+namespace {
+    using S = detail::Simd<uint8_t>;
+
+    /// Returns whether the supplied character is ASCII whitespace.
+    bool is_whitespace(char c) {
+        return c == ' ' || static_cast<unsigned char>(c - '\t') < 5;
+    }
+
+    /// Returns a mask with a bit set for each lane of the supplied vector which is (or is not)
+    /// ASCII whitespace.
+    uint32_t classify(S::type vector, bool whitespace) {
+        auto lanes = (S::type)((vector == S::splat(' ')) | (vector - S::splat('\t') < S::splat(5)));
+        return detail::movemask(whitespace ? lanes : ~lanes);
+    }
+}
+
+size_t detail::find_whitespace(const char* data, size_t size, bool whitespace) {
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+
+    size_t i = 0;
+    for (; i + S::LANES <= size; i += S::LANES) {
+        auto mask = classify(S::load(bytes + i), whitespace);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    for (; i < size; ++i) {
+        if (is_whitespace(data[i]) == whitespace) {
+            return i;
+        }
+    }
+    return size;
+}
+
+size_t detail::rfind_whitespace(const char* data, size_t size, bool whitespace) {
+    auto bytes = reinterpret_cast<const uint8_t*>(data);
+
+    size_t i = size;
+    for (; i >= S::LANES; i -= S::LANES) {
+        auto mask = classify(S::load(bytes + i - S::LANES), whitespace);
+        if (mask != 0) {
+            return i - S::LANES + (31 - __builtin_clz(mask));
+        }
+    }
+
+    while (i != 0) {
+        i -= 1;
+        if (is_whitespace(data[i]) == whitespace) {
+            return i;
+        }
+    }
+    return size;
+}
+
+}
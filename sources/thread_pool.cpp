@@ -0,0 +1,329 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <vivace/thread_pool.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace vce {
+
+namespace {
+    /// The number of times an idle worker looks for tasks before it sleeps.
+    constexpr size_t SPINS = 64;
+
+    /// The number of tasks a deque can hold before it first grows.
+    constexpr int64_t DEQUE_CAPACITY = 256;
+
+    /// A Chase-Lev work-stealing deque of jobs.
+    ///
+    /// The owner pushes and pops jobs at the bottom while other threads steal them from the top.
+    /// Arrays which are replaced as the deque grows are kept until the deque is destroyed because
+    /// thieves may still be reading from them.
+    class WorkDeque {
+        struct Array {
+            int64_t capacity;
+            std::unique_ptr<std::atomic<detail::Job*>[]> slots;
+
+            explicit Array(int64_t capacity)
+                : capacity{capacity}, slots{new std::atomic<detail::Job*>[capacity]} { }
+
+            detail::Job* get(int64_t index) const {
+                return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+            }
+
+            void put(int64_t index, detail::Job* job) {
+                slots[index & (capacity - 1)].store(job, std::memory_order_relaxed);
+            }
+        };
+
+        std::atomic<int64_t> top{0};
+        std::atomic<int64_t> bottom{0};
+        std::atomic<Array*> array;
+        std::vector<std::unique_ptr<Array>> arrays;
+
+    public:
+        WorkDeque() {
+            arrays.emplace_back(new Array{DEQUE_CAPACITY});
+            array.store(arrays.back().get(), std::memory_order_relaxed);
+        }
+
+        /// Pushes the supplied job onto the bottom of this deque, which only the owner may do.
+        void push(detail::Job* job) {
+            auto b = bottom.load(std::memory_order_relaxed);
+            auto t = top.load(std::memory_order_acquire);
+            auto a = array.load(std::memory_order_relaxed);
+            if (b - t >= a->capacity) {
+                arrays.emplace_back(new Array{2 * a->capacity});
+                auto grown = arrays.back().get();
+                for (auto i = t; i < b; ++i) {
+                    grown->put(i, a->get(i));
+                }
+                array.store(grown, std::memory_order_release);
+                a = grown;
+            }
+            a->put(b, job);
+            bottom.store(b + 1, std::memory_order_release);
+        }
+
+        /// Pops the job at the bottom of this deque, which only the owner may do.
+        detail::Job* pop() {
+            auto b = bottom.load(std::memory_order_relaxed) - 1;
+            auto a = array.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_seq_cst);
+            auto t = top.load(std::memory_order_seq_cst);
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            auto job = a->get(b);
+            if (t == b) {
+                // The last job may be stolen at the same time.
+                auto won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return won ? job : nullptr;
+            }
+            return job;
+        }
+
+        /// Steals the job at the top of this deque, which any thread may do.
+        ///
+        /// Returns null if the deque is empty or another thread took the job first.
+        detail::Job* steal() {
+            auto t = top.load(std::memory_order_seq_cst);
+            auto b = bottom.load(std::memory_order_seq_cst);
+            if (t >= b) {
+                return nullptr;
+            }
+            auto job = array.load(std::memory_order_acquire)->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst)) {
+                return nullptr;
+            }
+            return job;
+        }
+    };
+
+    /// A worker thread of a pool.
+    struct Worker {
+        /// The state of the pool this worker belongs to.
+        const void* pool;
+        size_t index;
+        WorkDeque deque;
+        /// The state of the generator of the workers to steal from.
+        uint64_t random;
+        std::thread thread;
+    };
+
+    /// The worker which is running on this thread, if any.
+    thread_local Worker* CURRENT = nullptr;
+
+    /// Pins the calling thread to the processor at the supplied index among those it may run on.
+    void pin(size_t index) {
+#ifdef __linux__
+        cpu_set_t available;
+        if (::sched_getaffinity(0, sizeof(available), &available) != 0) {
+            return;
+        }
+        auto count = static_cast<size_t>(CPU_COUNT(&available));
+        if (count == 0) {
+            return;
+        }
+        index %= count;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &available) && index-- == 0) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                // Pinning is only an optimization so failures are ignored.
+                ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+                return;
+            }
+        }
+#else
+        static_cast<void>(index);
+#endif
+    }
+}
+
+struct ThreadPool::State {
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex injector_mutex;
+    /// The jobs spawned by threads which are not workers.
+    std::deque<detail::Job*> injector;
+    std::atomic<size_t> injected{0};
+    /// The number of jobs which have been spawned but not yet taken by a worker.
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> sleeping{0};
+    std::atomic<bool> stopping{false};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+
+    /// Wakes a sleeping worker, if any, after a job is spawned.
+    void notify() {
+        if (sleeping.load(std::memory_order_seq_cst) != 0) {
+            std::lock_guard<std::mutex> lock{sleep_mutex};
+            wake.notify_one();
+        }
+    }
+
+    /// Takes a job from the supplied worker's deque, the shared queue or another worker's deque.
+    detail::Job* find(Worker& worker) {
+        auto job = worker.deque.pop();
+        if (job == nullptr && injected.load(std::memory_order_acquire) != 0) {
+            std::lock_guard<std::mutex> lock{injector_mutex};
+            if (!injector.empty()) {
+                job = injector.front();
+                injector.pop_front();
+                injected.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        if (job == nullptr && workers.size() > 1) {
+            // Victims are visited in turn starting from a random worker.
+            worker.random ^= worker.random << 13;
+            worker.random ^= worker.random >> 7;
+            worker.random ^= worker.random << 17;
+            auto start = static_cast<size_t>(worker.random % workers.size());
+            for (size_t i = 0; i < workers.size() && job == nullptr; ++i) {
+                auto& victim = *workers[(start + i) % workers.size()];
+                if (&victim != &worker) {
+                    job = victim.deque.steal();
+                }
+            }
+        }
+        if (job != nullptr) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    /// Runs jobs on the supplied worker until the pool is stopped and no jobs remain.
+    void run(Worker& worker) {
+        CURRENT = &worker;
+        while (true) {
+            detail::Job* job = nullptr;
+            for (size_t i = 0; i < SPINS && job == nullptr; ++i) {
+                job = find(worker);
+                if (job == nullptr) {
+                    std::this_thread::yield();
+                }
+            }
+            if (job != nullptr) {
+                job->run();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{sleep_mutex};
+            sleeping.fetch_add(1, std::memory_order_seq_cst);
+            while (queued.load(std::memory_order_seq_cst) == 0 && !stopping.load()) {
+                wake.wait(lock);
+            }
+            sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if (stopping.load() && queued.load() == 0) {
+                return;
+            }
+        }
+    }
+};
+
+std::string TaskError::message() const {
+    try {
+        std::rethrow_exception(exception_);
+    } catch (const std::exception& exception) {
+        return exception.what();
+    } catch (...) {
+        return "unknown exception";
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const TaskError& error) {
+    return stream << "TaskError(" << error.message() << ")";
+}
+
+ThreadPool::ThreadPool(size_t threads, Affinity affinity) : state{new State} {
+    if (threads == 0) {
+        detail::panic("attempted to create a thread pool without threads");
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        auto worker = new Worker{state.get(), i, {}, 0x9E3779B97F4A7C15 * (i + 1), {}};
+        state->workers.emplace_back(worker);
+    }
+    // The workers are started once they can all be stolen from.
+    for (auto& worker : state->workers) {
+        worker->thread = std::thread{[this, worker = worker.get(), affinity] {
+            if (affinity == Affinity::Pinned) {
+                pin(worker->index);
+            }
+            state->run(*worker);
+        }};
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{state->sleep_mutex};
+        state->stopping.store(true);
+    }
+    state->wake.notify_all();
+    for (auto& worker : state->workers) {
+        worker->thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool{std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+    return pool;
+}
+
+size_t ThreadPool::threads() const {
+    return state->workers.size();
+}
+
+void ThreadPool::submit(detail::Job* job) {
+    state->queued.fetch_add(1, std::memory_order_seq_cst);
+    auto worker = CURRENT;
+    if (worker != nullptr && worker->pool == state.get()) {
+        worker->deque.push(job);
+    } else {
+        std::lock_guard<std::mutex> lock{state->injector_mutex};
+        state->injector.push_back(job);
+        state->injected.fetch_add(1, std::memory_order_release);
+    }
+    state->notify();
+}
+
+void ThreadPool::wait(detail::TaskLatch& latch) {
+    auto worker = CURRENT;
+    if (worker != nullptr && worker->pool == state.get()) {
+        while (!latch.done()) {
+            auto job = state->find(*worker);
+            if (job != nullptr) {
+                job->run();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    latch.wait();
+}
+
+}
@@ -14,8 +14,14 @@
 
 #include <vivace/utility.hpp>
 
+#include <stdexcept>
+
 namespace vce {
 
+void detail::panic(const char* message) {
+    throw std::logic_error{message};
+}
+
 std::ostream& operator<<(std::ostream& stream, Ordering ordering) {
     switch (ordering) {
     case Ordering::Less:
@@ -0,0 +1,120 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/arena.hpp>
+#include <vivace/iterator.hpp>
+
+using namespace vce;
+
+#include <string>
+#include <vector>
+
+TEST(Allocate) {
+    Arena arena{64};
+    ASSERT_EQ(arena.capacity(), 0);
+
+    auto a = arena.allocate<char>(1);
+    auto b = arena.allocate<double>(1);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(b) % alignof(double), 0);
+    ASSERT_GT(static_cast<void*>(b), static_cast<void*>(a));
+    ASSERT_EQ(arena.capacity(), 64);
+
+    auto c = static_cast<char*>(arena.allocate(1, 64));
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(c) % 64, 0);
+
+    auto big = arena.allocate<char>(1000);
+    big[999] = 'x';
+    ASSERT_GE(arena.capacity(), 1064);
+
+    ASSERT_THROW(arena.allocate<uint64_t>(Limits<size_t>::max() / 4));
+}
+
+TEST(Reset) {
+    Arena arena{64};
+    auto first = arena.allocate<int>(1);
+    for (size_t i = 0; i < 100; ++i) {
+        arena.allocate<int>(10);
+    }
+    auto capacity = arena.capacity();
+
+    arena.reset();
+    ASSERT_EQ(arena.allocate<int>(1), first);
+    for (size_t i = 0; i < 100; ++i) {
+        arena.allocate<int>(10);
+    }
+    ASSERT_EQ(arena.capacity(), capacity);
+}
+
+TEST(Rewind) {
+    Arena arena{64};
+    arena.allocate<int>(4);
+
+    auto mark = arena.mark();
+    auto a = arena.allocate<int>(1);
+    arena.allocate<int>(100);
+    arena.rewind(mark);
+    ASSERT_EQ(arena.allocate<int>(1), a);
+
+    {
+        auto outer = arena.scope();
+        auto b = arena.allocate<int>(1);
+        {
+            auto inner = arena.scope();
+            auto c = arena.allocate<int>(1);
+            arena.allocate<int>(1000);
+            static_cast<void>(c);
+        }
+        auto d = arena.allocate<int>(1);
+        ASSERT_EQ(d, b + 1);
+    }
+    ASSERT_EQ(arena.allocate<int>(1), a + 1);
+
+    Arena empty;
+    auto start = empty.mark();
+    auto e = empty.allocate<int>(1);
+    empty.rewind(start);
+    ASSERT_EQ(empty.allocate<int>(1), e);
+}
+
+TEST(Allocator) {
+    Arena arena;
+    std::vector<std::string, ArenaAllocator<std::string>> strings{arena};
+    for (size_t i = 0; i < 100; ++i) {
+        strings.push_back(std::to_string(i));
+    }
+    ASSERT_EQ(strings[99], "99");
+    ASSERT_TRUE(strings.get_allocator() == ArenaAllocator<std::string>{arena});
+
+    Arena other;
+    ASSERT_TRUE(ArenaAllocator<int>{arena} != ArenaAllocator<int>{other});
+    ASSERT_TRUE(ArenaAllocator<int>{arena} == ArenaAllocator<std::string>{arena});
+    ASSERT_TRUE(ArenaAllocator<int>{arena} != ArenaAllocator<char>{other});
+}
+
+TEST(Collect) {
+    Arena arena{64};
+    auto values = range(0, 100).collect_in(arena);
+    ASSERT_EQ(values.size(), 100);
+    ASSERT_EQ(values[42], 42);
+    ASSERT_TRUE(values.get_allocator() == ArenaAllocator<int>{arena});
+
+    auto [even, odd] = range(0, 10).partition_in(arena, [](int i) { return i % 2 == 0; });
+    ASSERT_EQ(even.size(), 5);
+    ASSERT_EQ(odd[4], 9);
+    ASSERT_TRUE(even.get_allocator() == ArenaAllocator<int>{arena});
+}
@@ -0,0 +1,111 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/channel.hpp>
+
+using namespace vce;
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(SpscChannel) {
+    auto [sender, receiver] = spsc_channel<int>(16);
+    std::thread producer{[sender = std::move(sender)]() mutable {
+        for (int i = 0; i < 100000; ++i) {
+            sender.send(i).unwrap();
+        }
+    }};
+    ASSERT_EQ(receiver.map([](int i) { return int64_t{i}; }).sum(), 4999950000);
+    producer.join();
+
+    auto [batch, values] = spsc_channel<int64_t>(100);
+    std::thread batcher{[batch = std::move(batch)]() mutable {
+        ASSERT_EQ(batch.send_all(range(0, 100000)), 100000);
+    }};
+    int64_t expected = 0;
+    for (auto value : values) {
+        ASSERT_EQ(value, expected);
+        expected += 1;
+    }
+    ASSERT_EQ(expected, 100000);
+    batcher.join();
+}
+
+TEST(MpmcChannel) {
+    auto [sender, receiver] = mpmc_channel<int64_t>(64);
+    std::vector<std::thread> producers;
+    for (int64_t i = 0; i < 4; ++i) {
+        producers.emplace_back([sender = sender, i]() mutable {
+            ASSERT_EQ(sender.send_all(range<int64_t>(i * 25000, (i + 1) * 25000)), 25000);
+        });
+    }
+    { auto dropped = std::move(sender); }
+
+    std::vector<int64_t> sums(3);
+    std::vector<std::thread> consumers;
+    for (size_t i = 0; i < sums.size(); ++i) {
+        consumers.emplace_back([&sums, receiver = receiver, i]() mutable {
+            sums[i] = receiver.sum();
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    ASSERT_EQ(sums[0] + sums[1] + sums[2], 4999950000);
+    ASSERT_TRUE(receiver.next().is_none());
+}
+
+TEST(ChannelClosed) {
+    auto [sender, receiver] = spsc_channel<std::unique_ptr<int>>(4);
+    ASSERT_TRUE(receiver.try_next().is_none());
+    sender.send(std::make_unique<int>(1)).unwrap();
+    sender.send(std::make_unique<int>(2)).unwrap();
+    ASSERT_EQ(*receiver.try_next().unwrap(), 1);
+
+    // Values sent before the sender is dropped are still received.
+    sender.send(std::make_unique<int>(3)).unwrap();
+    { auto dropped = std::move(sender); }
+    ASSERT_EQ(*receiver.next().unwrap(), 2);
+    ASSERT_EQ(*receiver.next().unwrap(), 3);
+    ASSERT_TRUE(receiver.next().is_none());
+
+    // Sending fails once the receiver is dropped and unreceived values are destroyed.
+    auto [orphan, dropped] = mpmc_channel<std::unique_ptr<int>>(2);
+    orphan.send(std::make_unique<int>(4)).unwrap();
+    { auto receiver = std::move(dropped); }
+    ASSERT_EQ(*orphan.send(std::make_unique<int>(5)).unwrap_err(), 5);
+    ASSERT_EQ(orphan.send_all(range(0, 10).map([](int i) { return std::make_unique<int>(i); })),
+        0);
+
+    // A sender blocked on a full channel is woken when the receiver is dropped.
+    auto [blocked, full] = spsc_channel<int>(1);
+    blocked.send(1).unwrap();
+    std::thread dropper{[full = std::move(full)]() mutable {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto dropped = std::move(full);
+    }};
+    ASSERT_EQ(blocked.send(2).unwrap_err(), 2);
+    dropper.join();
+
+    ASSERT_THROW(spsc_channel<int>(0));
+}
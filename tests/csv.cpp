@@ -0,0 +1,129 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/csv.hpp>
+
+using namespace vce;
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using Row = std::vector<std::string>;
+using Rows = std::vector<Row>;
+
+/// Returns the fields of the supplied rows as strings.
+template <class I>
+Result<Rows, CsvError> strings(I iterator) {
+    Rows rows;
+    for (auto row : iterator) {
+        if (row.is_err()) {
+            return {ERR, row.unwrap_err()};
+        }
+        auto fields = row.unwrap();
+        rows.emplace_back(fields.begin(), fields.end());
+    }
+    return {OK, std::move(rows)};
+}
+
+TEST(Rows) {
+    auto rows = Rows{{"a", "b", "c"}, {"1", "2", "3"}};
+    ASSERT_EQ(strings(csv_rows("a,b,c\n1,2,3\n")).unwrap(), rows);
+    ASSERT_EQ(strings(csv_rows("a,b\r\n,\r\nc")).unwrap(), (Rows{{"a", "b"}, {"", ""}, {"c"}}));
+    ASSERT_EQ(strings(csv_rows("\n\n")).unwrap(), (Rows{{""}, {""}}));
+    ASSERT_EQ(strings(csv_rows("a,b\r")).unwrap(), (Rows{{"a", "b"}}));
+    ASSERT_EQ(strings(csv_rows("a,\"b\"\r")).unwrap(), (Rows{{"a", "b"}}));
+    ASSERT_EQ(strings(csv_rows("a,\r")).unwrap(), (Rows{{"a", ""}}));
+    ASSERT_EQ(strings(csv_rows("a\tb", '\t')).unwrap(), (Rows{{"a", "b"}}));
+    ASSERT_EQ(strings(csv_rows("")).unwrap(), Rows{});
+
+    std::string wide;
+    Row expected;
+    for (size_t i = 0; i < 100; ++i) {
+        expected.push_back(std::string(i % 40, 'x'));
+        wide += (i != 0 ? "," : "") + expected.back();
+    }
+    ASSERT_EQ(strings(csv_rows(wide)).unwrap(), Rows{expected});
+}
+
+TEST(Quoted) {
+    auto text = "\"a,b\",\"c\"\"d\",\"\"\n\"line\nbreak\",\"\"\"\"\r\nx,\"y\"";
+    auto rows = Rows{{"a,b", "c\"d", ""}, {"line\nbreak", "\""}, {"x", "y"}};
+    ASSERT_EQ(strings(csv_rows(text)).unwrap(), rows);
+
+    // Unescaped fields are views of the text.
+    std::string_view plain = "\"abc\",def";
+    auto iterator = csv_rows(plain);
+    auto fields = iterator.next().unwrap().unwrap();
+    ASSERT_EQ(fields[0].data(), plain.data() + 1);
+    ASSERT_EQ(fields[1].data(), plain.data() + 6);
+}
+
+TEST(Errors) {
+    auto unterminated = strings(csv_rows("a\n\"b,c\n")).unwrap_err();
+    ASSERT_EQ(unterminated, CsvError(CsvError::Kind::UnterminatedQuote, 1));
+    auto inside = strings(csv_rows("a\"b")).unwrap_err();
+    ASSERT_EQ(inside, CsvError(CsvError::Kind::InvalidQuote, 0));
+    auto after = strings(csv_rows("a\n\"b\"c")).unwrap_err();
+    ASSERT_EQ(after, CsvError(CsvError::Kind::InvalidQuote, 1));
+    ASSERT_FALSE(after.io().is_some());
+
+    auto iterator = csv_rows("\"");
+    ASSERT_TRUE(iterator.next().unwrap().is_err());
+    ASSERT_FALSE(iterator.next().is_some());
+}
+
+TEST(Lines) {
+    auto text = "a,\"b\"\r\n\"c\"\"\",d\n";
+    ASSERT_EQ(strings(csv_rows(lines(text))).unwrap(), (Rows{{"a", "b"}, {"c\"", "d"}}));
+    auto error = strings(csv_rows(lines("\"a\nb\""))).unwrap_err();
+    ASSERT_EQ(error, CsvError(CsvError::Kind::UnterminatedQuote, 0));
+}
+
+TEST(Chunks) {
+    std::string text;
+    Rows expected;
+    for (size_t i = 0; i < 500; ++i) {
+        auto quoted = std::string(i % 13, 'q') + "\"\"," + std::to_string(i) + "\n";
+        text += std::to_string(i) + ",\"" + quoted + "\"," + std::string(i % 29, 'x') + "\r\n";
+        quoted.erase(i % 13, 1);
+        expected.push_back({std::to_string(i), quoted, std::string(i % 29, 'x')});
+    }
+    text += "last,\"row\"";
+    expected.push_back({"last", "row"});
+
+    for (size_t size : {1, 2, 3, 7, 64, 4096, 1 << 20}) {
+        int fds[2];
+        ASSERT_EQ(::pipe(fds), 0);
+        std::thread writer{[&] {
+            auto written = ::write(fds[1], text.data(), text.size());
+            static_cast<void>(written);
+            ::close(fds[1]);
+        }};
+        auto rows = strings(csv_rows(read_chunks(fds[0], size))).unwrap();
+        writer.join();
+        ::close(fds[0]);
+        ASSERT_EQ(rows, expected);
+    }
+
+    auto error = strings(csv_rows(read_chunks(-1, 16))).unwrap_err();
+    ASSERT_EQ(error, CsvError(IoError{EBADF}, 0));
+    ASSERT_EQ(error.io().unwrap(), IoError{EBADF});
+}
@@ -0,0 +1,121 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/divider.hpp>
+
+using namespace vce;
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+template <class T>
+void check(T divisor, T value) {
+    auto d = divider(divisor).unwrap();
+    if (std::is_signed_v<T> && value == Limits<T>::min() && divisor == static_cast<T>(-1)) {
+        ASSERT_EQ(d.checked_div(value), Option<T>{});
+        ASSERT_EQ(d.div(value), Limits<T>::min());
+        ASSERT_EQ(d.rem(value), static_cast<T>(0));
+    } else {
+        ASSERT_EQ(d.div(value), static_cast<T>(value / divisor));
+        ASSERT_EQ(d.rem(value), static_cast<T>(value % divisor));
+        ASSERT_EQ(d.checked_div(value), Option<T>{static_cast<T>(value / divisor)});
+    }
+}
+
+template <class T>
+void exhaustive() {
+    for (int64_t divisor = Limits<T>::min(); divisor <= Limits<T>::max(); ++divisor) {
+        if (divisor != 0) {
+            for (int64_t value = Limits<T>::min(); value <= Limits<T>::max(); ++value) {
+                check(static_cast<T>(divisor), static_cast<T>(value));
+            }
+        }
+    }
+}
+
+template <class T>
+void sampled() {
+    std::mt19937_64 random{322};
+    std::vector<T> values;
+    for (auto value : {Limits<T>::min(), Limits<T>::max(), T(0), T(1), T(2), T(3), T(-1)}) {
+        values.push_back(value);
+        values.push_back(static_cast<T>(value / 2));
+    }
+    for (uint32_t shift = 0; shift < 8 * sizeof(T); ++shift) {
+        auto power = static_cast<T>(static_cast<uint64_t>(1) << shift);
+        values.push_back(power);
+        values.push_back(wrapping_sub(power, T(1)));
+        values.push_back(wrapping_add(power, T(1)));
+        values.push_back(wrapping_neg(power));
+    }
+    for (size_t i = 0; i < 200; ++i) {
+        values.push_back(static_cast<T>(random() >> (random() % (64 - 8 * sizeof(T) + 1))));
+    }
+
+    for (auto divisor : values) {
+        if (divisor != static_cast<T>(0)) {
+            for (auto value : values) {
+                check(divisor, value);
+            }
+        }
+    }
+}
+
+TEST(Zero) {
+    ASSERT_TRUE(divider<int32_t>(0).is_none());
+    ASSERT_TRUE(divider<uint64_t>(0).is_none());
+    ASSERT_EQ(divider<int32_t>(-7).unwrap().divisor(), -7);
+}
+
+TEST(Exhaustive) {
+    exhaustive<int8_t>();
+    exhaustive<uint8_t>();
+}
+
+TEST(Sampled) {
+    sampled<int16_t>();
+    sampled<uint16_t>();
+    sampled<int32_t>();
+    sampled<uint32_t>();
+    sampled<int64_t>();
+    sampled<uint64_t>();
+}
+
+TEST(Span) {
+    std::vector<int32_t> values;
+    for (int32_t value = -1000; value <= 1000; ++value) {
+        values.push_back(value);
+    }
+
+    auto d = divider<int32_t>(7).unwrap();
+    std::vector<int32_t> out(values.size());
+    d.div(values, out);
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(out[i], values[i] / 7);
+    }
+    d.rem(values, out);
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(out[i], values[i] % 7);
+    }
+
+    std::vector<uint64_t> small(3, 100);
+    std::vector<uint64_t> large(10, 1);
+    divider<uint64_t>(10).unwrap().div(small, large);
+    ASSERT_EQ(large, (std::vector<uint64_t>{10, 10, 10, 1, 1, 1, 1, 1, 1, 1}));
+}
@@ -0,0 +1,198 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/flat_hash.hpp>
+#include <vivace/iterator.hpp>
+
+using namespace vce;
+
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST(Insert) {
+    FlatHashSet<int> set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(set.capacity(), 0);
+    ASSERT_FALSE(set.contains(1));
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(set.insert(i).second);
+    }
+    ASSERT_EQ(set.size(), 1000);
+    ASSERT_LE(set.size(), set.capacity() - set.capacity() / 8);
+
+    for (int i = 0; i < 1000; ++i) {
+        auto [item, inserted] = set.insert(i);
+        ASSERT_FALSE(inserted);
+        ASSERT_EQ(*item, i);
+        ASSERT_TRUE(set.contains(i));
+    }
+    ASSERT_EQ(set.size(), 1000);
+    ASSERT_FALSE(set.contains(1000));
+    ASSERT_FALSE(set.contains(-1));
+    ASSERT_EQ(set.count(7), 1);
+    ASSERT_EQ(set.count(-7), 0);
+}
+
+TEST(Erase) {
+    FlatHashSet<std::string> set;
+    for (int i = 0; i < 500; ++i) {
+        set.insert(std::to_string(i));
+    }
+    auto capacity = set.capacity();
+
+    for (int i = 0; i < 500; i += 2) {
+        ASSERT_TRUE(set.erase(std::to_string(i)));
+    }
+    ASSERT_FALSE(set.erase("0"));
+    ASSERT_EQ(set.size(), 250);
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(set.contains(std::to_string(i)), i % 2 == 1);
+    }
+
+    // Repeatedly erasing and inserting reuses deleted slots instead of growing the table.
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 1000; i < 1200; ++i) {
+            set.insert(std::to_string(i));
+        }
+        for (int i = 1000; i < 1200; ++i) {
+            ASSERT_TRUE(set.erase(std::to_string(i)));
+        }
+    }
+    ASSERT_EQ(set.size(), 250);
+    ASSERT_EQ(set.capacity(), capacity);
+
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    ASSERT_EQ(set.capacity(), capacity);
+    ASSERT_FALSE(set.contains("1"));
+    ASSERT_EQ(set.begin(), set.end());
+}
+
+TEST(Map) {
+    FlatHashMap<std::string, int> map;
+    map["a"] = 1;
+    map["b"] += 2;
+    map["a"] += 10;
+    ASSERT_EQ(map.size(), 2);
+    ASSERT_EQ(map["a"], 11);
+    ASSERT_EQ(map.get("b").unwrap().get(), 2);
+    ASSERT_FALSE(map.get("c").is_some());
+
+    auto [entry, inserted] = map.try_emplace("c", 3);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(entry->second, 3);
+    ASSERT_FALSE(map.try_emplace("c", 4).second);
+    ASSERT_EQ(map.find("c")->second, 3);
+    ASSERT_EQ(map.find("d"), map.end());
+
+    const auto& cmap = map;
+    ASSERT_EQ(cmap.get("a").unwrap().get(), 11);
+    ASSERT_EQ(cmap.find("a")->second, 11);
+
+    FlatHashMap<int, std::unique_ptr<int>> owners;
+    for (int i = 0; i < 100; ++i) {
+        owners.try_emplace(i, std::make_unique<int>(i));
+    }
+    auto moved = std::move(owners);
+    ASSERT_EQ(moved.size(), 100);
+    ASSERT_EQ(*moved[42], 42);
+}
+
+TEST(Copy) {
+    FlatHashMap<int, std::string> map;
+    for (int i = 0; i < 100; ++i) {
+        map[i] = std::to_string(i);
+    }
+
+    auto copy = map;
+    ASSERT_EQ(copy, map);
+    copy[0] = "zero";
+    ASSERT_NE(copy, map);
+    copy = map;
+    ASSERT_EQ(copy, map);
+    copy.erase(99);
+    ASSERT_NE(copy, map);
+
+    FlatHashSet<int> set{3, 1, 2, 3};
+    ASSERT_EQ(set.size(), 3);
+    ASSERT_EQ(set, (FlatHashSet<int>{1, 2, 3}));
+
+    static_assert(std::is_nothrow_move_constructible_v<FlatHashMap<int, std::string>>);
+    static_assert(std::is_nothrow_move_assignable_v<FlatHashSet<std::string>>);
+    std::vector<FlatHashMap<int, std::string>> maps(1, map);
+    auto entries = &*maps[0].begin();
+    maps.resize(maps.capacity() + 1);
+    ASSERT_EQ(&*maps[0].begin(), entries);
+}
+
+TEST(Iterate) {
+    FlatHashSet<int> set;
+    ASSERT_EQ(set.begin(), set.end());
+
+    int expected = 0;
+    for (int i = 0; i < 1000; ++i) {
+        set.insert(i);
+        expected += i;
+    }
+    for (int i = 0; i < 1000; i += 3) {
+        set.erase(i);
+        expected -= i;
+    }
+
+    int total = 0;
+    size_t count = 0;
+    for (auto item : set) {
+        total += item;
+        count += 1;
+    }
+    ASSERT_EQ(total, expected);
+    ASSERT_EQ(count, set.size());
+
+    // The items of a hash set can't be counted without walking them.
+    static_assert(!decltype(container(set))::HAS_SIZE);
+    ASSERT_EQ(container(set).map([](auto i) { return i.get(); }).sum(), expected);
+    ASSERT_EQ(container(set).collect().size(), set.size());
+}
+
+TEST(Collect) {
+    std::vector<std::string> strings{"a", "b", "c", "b"};
+
+    auto indices = container(strings)
+        .map([](auto s) { return s.get(); })
+        .enumerate()
+        .map([](auto p) { return std::make_pair(p.second, p.first); })
+        .collect<FlatHashMap<std::string, size_t>>();
+    ASSERT_EQ(indices.size(), 3);
+    ASSERT_EQ(indices["a"], 0);
+    ASSERT_EQ(indices["b"], 1);
+    ASSERT_EQ(indices["c"], 2);
+
+    auto squares = range(0, 100).zip(range(0, 100).map([](auto i) { return i * i; }))
+        .collect<FlatHashMap<int, int>>();
+    ASSERT_EQ(squares.size(), 100);
+    ASSERT_EQ(squares[9], 81);
+    ASSERT_GE(squares.capacity(), 100);
+
+    auto set = range(0, 1000).map([](auto i) { return i % 10; }).collect<FlatHashSet<int>>();
+    ASSERT_EQ(set.size(), 10);
+
+    auto pairs = container(std::move(squares)).collect<std::vector<std::pair<int, int>>>();
+    ASSERT_EQ(pairs.size(), 100);
+}
@@ -0,0 +1,102 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/format.hpp>
+
+using namespace vce;
+
+#include <limits>
+#include <sstream>
+#include <string>
+
+/// Returns the representation of the supplied value formatted into a buffer of its maximum size.
+template <class T>
+static std::string format(const T& value) {
+    char buffer[FORMAT_SIZE<T>];
+    return {buffer, static_cast<size_t>(format_to(buffer, value) - buffer)};
+}
+
+/// Returns the representation of the supplied value written by `operator<<`.
+template <class T>
+static std::string stream(const T& value) {
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+TEST(FormatNumbers) {
+    ASSERT_EQ(format(0), "0");
+    ASSERT_EQ(format(std::numeric_limits<int64_t>::min()), "-9223372036854775808");
+    ASSERT_EQ(format(std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+    ASSERT_EQ(format(std::numeric_limits<int8_t>::min()), "-128");
+    ASSERT_EQ(format(0.1), "0.1");
+    ASSERT_EQ(format(-std::numeric_limits<double>::denorm_min()), "-5e-324");
+    ASSERT_EQ(format(-std::numeric_limits<double>::max()), "-1.7976931348623157e+308");
+    ASSERT_EQ(format(-std::numeric_limits<float>::min()), "-1.1754944e-38");
+    ASSERT_EQ(format(true), "true");
+    ASSERT_EQ(format('x'), "x");
+
+    static_assert(FORMAT_SIZE<int64_t> == 20);
+    static_assert(FORMAT_SIZE<uint64_t> == 20);
+    static_assert(FORMAT_SIZE<double> >= 24);
+}
+
+TEST(FormatTypes) {
+    ASSERT_EQ(format(Option<int>{}), stream(Option<int>{}));
+    ASSERT_EQ(format(Option<int>{-42}), stream(Option<int>{-42}));
+    ASSERT_EQ(format(Option<Option<Unit>>{Option<Unit>{Unit{}}}), "Some(Some(()))");
+
+    using R = Result<int, Ordering>;
+    ASSERT_EQ(format(R{OK, 7}), stream(R{OK, 7}));
+    ASSERT_EQ(format(R{ERR, Ordering::Greater}), stream(R{ERR, Ordering::Greater}));
+
+    for (auto ordering : {Ordering::Less, Ordering::Equal, Ordering::Greater}) {
+        ASSERT_EQ(format(ordering), stream(ordering));
+    }
+    ASSERT_EQ(format(Unit{}), stream(Unit{}));
+
+    auto max = std::numeric_limits<size_t>::max();
+    ASSERT_EQ(format(Bounds{3}), stream(Bounds{3}));
+    ASSERT_EQ(format(Bounds{max, max}), stream(Bounds{max, max}));
+    ASSERT_EQ(FORMAT_SIZE<Bounds>, format(Bounds{max, max}).size());
+
+    static_assert(FORMAT_SIZE<Option<int>> == 17);
+    static_assert(FORMAT_SIZE<Result<Unit, Ordering>> == 12);
+    static_assert(!detail::HasFormatSizeV<detail::Formatter<Option<std::string>>>);
+}
+
+TEST(FormatToString) {
+    std::string buffer{"x="};
+    ASSERT_EQ(format_to(buffer, Option<double>{2.5}), 9);
+    ASSERT_EQ(buffer, "x=Some(2.5)");
+
+    buffer.clear();
+    Result<std::string, int> result{OK, "text"};
+    ASSERT_EQ(format_to(buffer, result), 8);
+    ASSERT_EQ(buffer, "Ok(text)");
+
+    int value = 5;
+    buffer.clear();
+    format_to(buffer, Option<Ref<int>>{std::ref(value)});
+    ASSERT_EQ(buffer, "Some(5)");
+
+    buffer.clear();
+    write_to(range(0, 3).map([](int i) { return Option<int>{i}; }), buffer, " ");
+    ASSERT_EQ(buffer, "Some(0) Some(1) Some(2)");
+}
@@ -0,0 +1,88 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/iterator.hpp>
+
+using namespace vce;
+
+#include <set>
+#include <string>
+#include <vector>
+
+template <class T>
+uint64_t hash(const T& value, uint64_t seed = 0) {
+    Hasher hasher{seed};
+    hash_combine(hasher, value);
+    return hasher.finish();
+}
+
+TEST(Integers) {
+    ASSERT_EQ(hash(322), hash(322));
+    ASSERT_NE(hash(322), hash(323));
+    ASSERT_NE(hash(322), hash(322, 1));
+    ASSERT_EQ(hash(-1), hash(static_cast<int64_t>(-1)));
+    ASSERT_EQ(hash(Ordering::Less), hash(-1));
+
+    // Sequential keys should fill the buckets of a small power-of-two table.
+    std::set<uint64_t> buckets;
+    for (uint64_t i = 0; i < 4096; ++i) {
+        buckets.insert(hash(i << 12) & 1023);
+    }
+    ASSERT_GT(buckets.size(), 1000);
+}
+
+TEST(Floats) {
+    ASSERT_EQ(hash(0.0), hash(-0.0));
+    ASSERT_EQ(hash(0.5f), hash(0.5));
+    ASSERT_NE(hash(0.5), hash(0.25));
+}
+
+TEST(Strings) {
+    std::string bytes;
+    std::set<uint64_t> hashes;
+    for (size_t size = 0; size < 200; ++size) {
+        ASSERT_EQ(hash(bytes), hash(std::string_view{bytes}));
+        hashes.insert(hash(bytes));
+        bytes.push_back(static_cast<char>('a' + size % 26));
+    }
+    ASSERT_EQ(hashes.size(), 200);
+
+    ASSERT_EQ(hash("abc"), hash(std::string{"abc"}));
+    ASSERT_NE(hash(std::make_pair(std::string{"ab"}, std::string{"c"})),
+              hash(std::make_pair(std::string{"a"}, std::string{"bc"})));
+}
+
+TEST(Composite) {
+    ASSERT_NE(hash(Option<int>{}), hash(Option<int>{0}));
+    ASSERT_NE(hash(Option<int>{0}), hash(0));
+    ASSERT_EQ(hash(Option<Unit>{UNIT}), hash(Option<Unit>{UNIT}));
+    ASSERT_NE(hash(Option<Unit>{UNIT}), hash(Option<Unit>{}));
+
+    ASSERT_NE(hash(Result<int, int>{OK, 1}), hash(Result<int, int>{ERR, 1}));
+    ASSERT_EQ(hash(Result<int, int>{ERR, 1}), hash(Result<int, int>{ERR, 1}));
+
+    ASSERT_NE(hash(std::make_pair(1, 2)), hash(std::make_pair(2, 1)));
+    ASSERT_EQ(hash(std::make_pair(1, Option<int>{2})), hash(std::make_pair(1, Option<int>{2})));
+
+    ASSERT_NE(hash(Bounds{1}), hash(Bounds{1, 1}));
+    ASSERT_EQ(hash(Bounds{1, 2}), hash(Bounds{1, Option<size_t>{2}}));
+
+    ASSERT_EQ(Option<int>{5}.hash(), Hash{}(Option<int>{5}));
+    ASSERT_EQ(std::hash<Option<int>>{}(Option<int>{5}), Hash{}(Option<int>{5}));
+    ASSERT_EQ((Result<int, int>{OK, 5}.hash()), (Hash{}(Result<int, int>{OK, 5})));
+}
@@ -0,0 +1,305 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/io.hpp>
+
+using namespace vce;
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/// A temporary file which is removed when it is destroyed.
+class TempFile {
+    std::string path_;
+
+public:
+    TempFile(std::string_view contents) {
+        char path[] = "/tmp/vivace-io-XXXXXX";
+        auto fd = ::mkstemp(path);
+        auto written = ::write(fd, contents.data(), contents.size());
+        static_cast<void>(written);
+        ::close(fd);
+        path_ = path;
+    }
+
+    ~TempFile() {
+        std::remove(path_.c_str());
+    }
+
+    const char* path() const {
+        return path_.c_str();
+    }
+};
+
+using Strings = std::vector<std::string_view>;
+
+TEST(MappedFile) {
+    TempFile file{"hello"};
+    auto mapped = MappedFile::open(file.path()).unwrap();
+    ASSERT_EQ(mapped.bytes(), "hello");
+    ASSERT_EQ(mapped.size(), 5);
+
+    auto moved = std::move(mapped);
+    ASSERT_EQ(moved.bytes(), "hello");
+    ASSERT_EQ(mapped.data(), nullptr);
+
+    TempFile empty{""};
+    ASSERT_EQ(MappedFile::open(empty.path(), MappedFile::Access::Random).unwrap().size(), 0);
+
+    auto missing = MappedFile::open("/nonexistent/vivace");
+    ASSERT_EQ(missing.unwrap_err(), IoError{ENOENT});
+    ASSERT_EQ(MappedFile::open("/tmp").unwrap_err(), IoError{EISDIR});
+}
+
+TEST(MmapLines) {
+    TempFile file{"first\r\nsecond\n\nfourth\n"};
+    auto lines = mmap_lines(file.path()).unwrap();
+    auto moved = std::move(lines);
+    ASSERT_EQ(moved.collect(), (Strings{"first", "second", "", "fourth"}));
+
+    auto iterator = mmap_lines(file.path()).unwrap();
+    ASSERT_EQ(iterator.as_ref().reverse().take(2).collect(), (Strings{"fourth", ""}));
+    ASSERT_EQ(iterator.next().unwrap(), "first");
+
+    TempFile empty{""};
+    ASSERT_EQ(mmap_lines(empty.path()).unwrap().count(), 0);
+    ASSERT_EQ(mmap_lines("/nonexistent/vivace").unwrap_err(), IoError{ENOENT});
+}
+
+struct Record {
+    uint32_t id;
+    uint32_t value;
+};
+
+TEST(MmapRecords) {
+    std::vector<Record> records;
+    for (uint32_t i = 0; i < 100; ++i) {
+        records.push_back({i, i * i});
+    }
+    std::string_view bytes{reinterpret_cast<const char*>(records.data()), 100 * sizeof(Record)};
+    TempFile file{bytes};
+
+    auto iterator = mmap_records<Record>(file.path()).unwrap();
+    ASSERT_EQ(iterator.size(), 100);
+    ASSERT_EQ(iterator.get(10).unwrap().get().value, 100);
+    ASSERT_FALSE(iterator.get(100).is_some());
+
+    auto [left, right] = iterator.split_at(40);
+    ASSERT_EQ(left.size(), 40);
+    ASSERT_EQ(right.size(), 60);
+    ASSERT_EQ(right.next().unwrap().get().id, 40);
+    ASSERT_EQ(right.next_back().unwrap().get().id, 99);
+
+    // The halves keep the mapping alive after the original iterator is gone.
+    iterator = mmap_records<Record>(file.path()).unwrap();
+    auto sum = [](auto i) { return static_cast<uint64_t>(i.get().value); };
+    auto total = left.map(sum).sum() + right.map(sum).sum();
+    ASSERT_EQ(total, 328350 - 40 * 40 - 99 * 99);
+
+    TempFile truncated{bytes.substr(0, 7)};
+    ASSERT_EQ(mmap_records<Record>(truncated.path()).unwrap_err(), IoError{EINVAL});
+}
+
+/// Returns the bytes in the supplied chunk as a string.
+static std::string text(Span<const std::byte> chunk) {
+    return {reinterpret_cast<const char*>(chunk.data()), chunk.size()};
+}
+
+TEST(ReadChunks) {
+    std::string contents;
+    for (size_t i = 0; i < 1000; ++i) {
+        contents += std::to_string(i) + ",";
+    }
+    TempFile file{contents};
+
+    auto fd = ::open(file.path(), O_RDONLY);
+    std::string read;
+    std::vector<const std::byte*> buffers;
+    for (auto chunk : read_chunks(fd, 100)) {
+        auto bytes = chunk.unwrap();
+        ASSERT_TRUE(bytes.size() == 100 || read.size() + bytes.size() == contents.size());
+        read += text(bytes);
+        buffers.push_back(bytes.data());
+    }
+    ::close(fd);
+    ASSERT_EQ(read, contents);
+
+    // The two buffers are reused in turn.
+    ASSERT_NE(buffers[0], buffers[1]);
+    for (size_t i = 2; i < buffers.size(); ++i) {
+        ASSERT_EQ(buffers[i], buffers[i - 2]);
+    }
+
+    TempFile empty{""};
+    fd = ::open(empty.path(), O_RDONLY);
+    ASSERT_EQ(read_chunks(fd, 100).count(), 0);
+    ::close(fd);
+
+    using Chunks = Result<std::vector<Span<const std::byte>>, IoError>;
+    ASSERT_EQ(read_chunks(-1, 100).collect<Chunks>().unwrap_err(), IoError{EBADF});
+}
+
+TEST(ReadChunksPipe) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    std::thread writer{[&] {
+        for (size_t i = 0; i < 1000; ++i) {
+            auto written = ::write(fds[1], "0123456789", 10);
+            static_cast<void>(written);
+        }
+        ::close(fds[1]);
+    }};
+
+    std::string read;
+    for (auto chunk : read_chunks(fds[0], 4096)) {
+        auto bytes = chunk.unwrap();
+        ASSERT_TRUE(!bytes.empty() && bytes.size() <= 4096);
+        read += text(bytes);
+    }
+    writer.join();
+    ::close(fds[0]);
+    ASSERT_EQ(read.size(), 10000);
+    ASSERT_EQ(read.substr(9990), "0123456789");
+
+    // Dropping an iterator before the end stops the background thread.
+    ASSERT_EQ(::pipe(fds), 0);
+    auto written = ::write(fds[1], "0123456789", 10);
+    static_cast<void>(written);
+    ::close(fds[1]);
+    {
+        auto chunks = read_chunks(fds[0], 4);
+        ASSERT_EQ(text(chunks.next().unwrap().unwrap()), "0123");
+        auto moved = std::move(chunks);
+        ASSERT_EQ(text(moved.next().unwrap().unwrap()), "4567");
+        moved = read_chunks(fds[0], 4);
+    }
+    ::close(fds[0]);
+}
+
+TEST(ReadChunksOpenPipe) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    // Data is emitted before the chunk is full and dropping the iterator doesn't wait for the
+    // writer to close the pipe.
+    auto written = ::write(fds[1], "abc", 3);
+    static_cast<void>(written);
+    {
+        auto chunks = read_chunks(fds[0], 4096);
+        ASSERT_EQ(text(chunks.next().unwrap().unwrap()), "abc");
+    }
+    {
+        auto chunks = read_chunks(fds[0], 4096);
+        auto moved = std::move(chunks);
+        moved = read_chunks(fds[0], 4096);
+    }
+    ::close(fds[1]);
+    ::close(fds[0]);
+}
+
+TEST(WriteToString) {
+    std::string buffer{">"};
+    ASSERT_EQ(write_to(range(1, 4), buffer, ", "), 7);
+    ASSERT_EQ(buffer, ">1, 2, 3");
+
+    std::vector<std::string> words{"a", "bc", "def"};
+    buffer.clear();
+    ASSERT_EQ(write_to(container(words), buffer), 6);
+    ASSERT_EQ(buffer, "abcdef");
+
+    buffer.clear();
+    std::vector<double> numbers{0.5, -2.0, 1e100};
+    write_to(container(numbers), buffer, " ");
+    ASSERT_EQ(buffer, "0.5 -2 1e+100");
+
+    buffer.clear();
+    std::vector<bool> flags{true, false};
+    write_to(container(std::move(flags)), buffer, "\n");
+    ASSERT_EQ(buffer, "true\nfalse");
+
+    buffer.clear();
+    std::byte bytes[] = {std::byte{'x'}, std::byte{'y'}};
+    std::vector<Span<const std::byte>> spans{bytes, bytes};
+    ASSERT_EQ(write_to(container(spans), buffer, std::string_view{"\0", 1}), 5);
+    ASSERT_EQ(buffer, std::string_view("xy\0xy", 5));
+}
+
+TEST(WriteToFd) {
+    TempFile file{""};
+    auto fd = ::open(file.path(), O_WRONLY | O_TRUNC);
+    ASSERT_EQ(write_to(range(0, 100000), fd, "\n").unwrap(), 588889);
+    ::close(fd);
+
+    auto lines = mmap_lines(file.path()).unwrap();
+    ASSERT_TRUE(lines.eq(range(0, 100000).map([](int i) { return std::to_string(i); })));
+
+    ASSERT_EQ(write_to(range(0, 10), -1).unwrap_err(), IoError{EBADF});
+    ASSERT_EQ(write_to(range(0, 0), -1).unwrap(), 0);
+}
+
+TEST(Writer) {
+    TempFile file{""};
+    auto fd = ::open(file.path(), O_WRONLY | O_TRUNC);
+    std::string large(10000, 'x');
+    {
+        // Values which don't fit in the buffer are written along with it.
+        Writer writer{fd, 16};
+        writer.write("0123456789");
+        writer.write(large);
+        writer.write(std::string_view{"abcdefghij"});
+        writer.write(std::string_view{"klmnopqrst"});
+        writer.write('!');
+        ASSERT_FALSE(writer.failed());
+        ASSERT_EQ(writer.flush().unwrap(), 10031);
+        writer.write(-42);
+    }
+    ::close(fd);
+    auto mapped = MappedFile::open(file.path()).unwrap();
+    ASSERT_EQ(mapped.bytes(), "0123456789" + large + "abcdefghijklmnopqrst!-42");
+
+    // Writes to a pipe which is drained by another thread are continued after short writes.
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    std::string read;
+    std::thread reader{[&] {
+        char chunk[4096];
+        ssize_t count;
+        while ((count = ::read(fds[0], chunk, sizeof chunk)) > 0) {
+            read.append(chunk, static_cast<size_t>(count));
+        }
+    }};
+    std::string huge(1 << 20, 'y');
+    std::vector<std::string_view> items{"start", huge, "end"};
+    ASSERT_EQ(write_to(container(items), fds[1]).unwrap(), huge.size() + 8);
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+    ASSERT_EQ(read, "start" + huge + "end");
+
+    Writer failed{-1, 16};
+    failed.write(large);
+    ASSERT_TRUE(failed.failed());
+    failed.write("more");
+    ASSERT_EQ(failed.flush().unwrap_err(), IoError{EBADF});
+}
@@ -20,6 +20,8 @@ ACCEL_TESTS
 
 using namespace vce;
 
+#include <algorithm>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -394,6 +396,35 @@ TEST(Collect) {
     using Map = std::unordered_map<size_t, uint64_t>;
     auto map = range(1, 4).enumerate().collect<Map>();
     ASSERT_EQ(map, (Map{{0, 1}, {1, 2}, {2, 3}}));
+
+    auto odd = [](auto i) { return i % 2 == 1; };
+    auto filtered = range(1, 8).filter(odd).map([](auto i) { return i * 2; }).take(3);
+    static_assert(!decltype(filtered)::HAS_SIZE);
+    static_assert(decltype(range(1, 8).map(odd).take(3))::HAS_SIZE);
+    ASSERT_EQ(filtered.collect(), (std::vector<int>{2, 6, 10}));
+}
+
+TEST(CollectTry) {
+    using R = Result<int, std::string>;
+    using C = Result<std::vector<int>, std::string>;
+
+    auto f = [](auto i) { return i != 4 ? R{OK, i} : R{ERR, std::to_string(i)}; };
+
+    ASSERT_EQ(range(1, 1).map(f).collect<C>(), (C{OK, std::vector<int>{}}));
+    ASSERT_EQ(range(1, 4).map(f).collect<C>(), (C{OK, std::vector<int>{1, 2, 3}}));
+
+    size_t count = 0;
+    auto g = [&](auto i) { count += 1; return f(i); };
+    ASSERT_EQ(range(1, 9).map(g).collect<C>(), (C{ERR, "4"}));
+    ASSERT_EQ(count, 4);
+
+    using O = Option<int>;
+    using V = Option<std::vector<int>>;
+
+    auto h = [](auto i) { return i != 4 ? O{i} : O{}; };
+
+    ASSERT_EQ(range(1, 4).map(h).collect<V>(), (V{std::vector<int>{1, 2, 3}}));
+    ASSERT_EQ(range(1, 9).map(h).collect<V>(), (V{}));
 }
 
 TEST(Partition) {
@@ -407,6 +438,74 @@ TEST(Partition) {
     ASSERT_EQ(right, (Map{{3, 4}, {4, 5}, {5, 6}}));
 }
 
+TEST(Sorted) {
+    ASSERT_EQ(range(1, 1).sorted(), std::vector<int>{});
+    ASSERT_EQ(range(1, 4).reverse().sorted(), (std::vector<int>{1, 2, 3}));
+
+    std::vector<std::string> strings{"c", "a", "b"};
+    auto sorted = container(strings).sorted();
+    ASSERT_EQ(sorted.size(), 3);
+    ASSERT_EQ(sorted[0].get(), "a");
+    ASSERT_EQ(sorted[2].get(), "c");
+
+    std::vector<double> floats{2.5, -0.0, -1.5, 0.0, -3.0, 1e300, -1e300};
+    for (size_t i = 0; i < 500; ++i) {
+        floats.push_back(static_cast<double>(i % 37) - 18.5);
+    }
+    auto expected = floats;
+    std::stable_sort(expected.begin(), expected.end());
+    ASSERT_EQ(container(std::move(floats)).sorted(), expected);
+
+    for (size_t size : {10, 1000}) {
+        std::vector<int64_t> integers;
+        for (size_t i = 0; i < size; ++i) {
+            integers.push_back(static_cast<int64_t>(i * 2654435761u % 1001) - 500);
+        }
+        integers.push_back(Limits<int64_t>::min());
+        integers.push_back(Limits<int64_t>::max());
+        auto expected = integers;
+        std::sort(expected.begin(), expected.end());
+        ASSERT_EQ(container(std::move(integers)).sorted(), expected);
+    }
+}
+
+TEST(SortedByKey) {
+    for (size_t size : {10, 1000}) {
+        std::vector<std::pair<int, size_t>> pairs;
+        for (size_t i = 0; i < size; ++i) {
+            pairs.emplace_back(static_cast<int>(i * 7 % 13) - 6, i);
+        }
+
+        size_t calls = 0;
+        auto key = [&](const auto& pair) { calls += 1; return pair.first; };
+        auto sorted = container(pairs).map([](auto p) { return p.get(); }).sorted_by_key(key);
+        ASSERT_EQ(calls, size);
+
+        auto expected = pairs;
+        auto less = [](const auto& l, const auto& r) { return l.first < r.first; };
+        std::stable_sort(expected.begin(), expected.end(), less);
+        ASSERT_EQ(sorted, expected);
+
+        auto unstable = container(pairs).map([](auto p) { return p.get(); })
+            .sorted_unstable_by_key([](const auto& pair) { return pair.first; });
+        ASSERT_TRUE(std::is_sorted(unstable.begin(), unstable.end(), less));
+        ASSERT_TRUE(std::is_permutation(unstable.begin(), unstable.end(), pairs.begin()));
+    }
+
+    std::vector<std::string> strings{"bb", "a", "ccc", "dd"};
+    auto key = [](const auto& string) { return string.get().size(); };
+    auto sorted = container(strings).sorted_by_key(key);
+    ASSERT_EQ(sorted[0].get(), "a");
+    ASSERT_EQ(sorted[1].get(), "bb");
+    ASSERT_EQ(sorted[2].get(), "dd");
+    ASSERT_EQ(sorted[3].get(), "ccc");
+
+    auto copy = [](auto string) { return std::string{string.get()}; };
+    auto lexicographic = container(strings).sorted_by_key(copy);
+    ASSERT_EQ(lexicographic[0].get(), "a");
+    ASSERT_EQ(lexicographic[3].get(), "dd");
+}
+
 TEST(Sum) {
     ASSERT_EQ(range(1, 1).sum(), 0);
     ASSERT_EQ(range(1, 7).sum(), 21);
@@ -417,6 +516,13 @@ TEST(Product) {
     ASSERT_EQ(range(1, 7).product(), 720);
 }
 
+TEST(SaturatingSum) {
+    ASSERT_EQ(range<int8_t>(1, 1).saturating_sum(), 0);
+    ASSERT_EQ(range<int8_t>(1, 7).saturating_sum(), 21);
+    ASSERT_EQ(range<int8_t>(1, 100).saturating_sum(), 127);
+    ASSERT_EQ(range<int8_t>(-100, 0).saturating_sum(), -128);
+}
+
 TEST(All) {
     auto f = [](auto i) { return i != 4; };
 
@@ -453,6 +559,204 @@ TEST(Position) {
     ASSERT_EQ(range(4, 9).position(f), Option<size_t>{0});
 }
 
+template <class T>
+void minmax() {
+    for (size_t size : {1, 2, 3, 31, 32, 33, 1000, 1024, 1025, 5000}) {
+        std::vector<T> values;
+        for (size_t i = 0; i < size; ++i) {
+            values.push_back(static_cast<T>(i * 2654435761u % 97));
+        }
+
+        auto min = &container(values).min().unwrap().get();
+        auto max = &container(values).max().unwrap().get();
+
+        auto actual = container(values).minmax().unwrap();
+        ASSERT_TRUE(&actual.first.get() == min);
+        ASSERT_TRUE(&actual.second.get() == max);
+
+        auto generic = container(values).map([](auto v) { return v; }).minmax().unwrap();
+        ASSERT_TRUE(&generic.first.get() == min);
+        ASSERT_TRUE(&generic.second.get() == max);
+    }
+}
+
+TEST(MinMax) {
+    ASSERT_EQ(range(1, 1).minmax(), (Option<std::pair<int, int>>{}));
+    ASSERT_EQ(range(1, 2).minmax(), (Option<std::pair<int, int>>{{1, 1}}));
+    ASSERT_EQ(range(1, 5).minmax(), (Option<std::pair<int, int>>{{1, 4}}));
+    ASSERT_EQ(range(1, 6).reverse().minmax(), (Option<std::pair<int, int>>{{1, 5}}));
+
+    minmax<int8_t>();
+    minmax<uint8_t>();
+    minmax<int32_t>();
+    minmax<uint64_t>();
+
+    std::vector<std::string> strings{"b", "a", "c", "a", "c", "b"};
+    auto [min, max] = container(strings).minmax().unwrap();
+    ASSERT_EQ(&min.get(), &strings[1]);
+    ASSERT_EQ(&max.get(), &strings[4]);
+}
+
+TEST(MinMaxByKey) {
+    ASSERT_EQ(range(1, 1).minmax_by_key([](auto i) { return i; }), (Option<std::pair<int, int>>{}));
+
+    size_t calls = 0;
+    auto key = [&](auto i) { calls += 1; return i % 3; };
+    ASSERT_EQ(range(0, 10).minmax_by_key(key), (Option<std::pair<int, int>>{{0, 8}}));
+    ASSERT_EQ(calls, 10);
+
+    for (int end = 1; end < 10; ++end) {
+        auto expected = std::make_pair(range(0, end).min_by_key(key).unwrap(),
+                                       range(0, end).max_by_key(key).unwrap());
+        ASSERT_EQ(range(0, end).minmax_by_key(key).unwrap(), expected);
+    }
+
+    std::vector<std::string> strings{"bb", "a", "ccc", "d", "eee"};
+    auto length = [](const auto& string) { return string.get().size(); };
+    auto [min, max] = container(strings).minmax_by_key(length).unwrap();
+    ASSERT_EQ(&min.get(), &strings[1]);
+    ASSERT_EQ(&max.get(), &strings[4]);
+}
+
+TEST(Cmp) {
+    ASSERT_EQ(range(1, 1).cmp(range(1, 1)), Ordering::Equal);
+    ASSERT_EQ(range(1, 4).cmp(range(1, 4)), Ordering::Equal);
+    ASSERT_EQ(range(1, 4).cmp(range(1, 5)), Ordering::Less);
+    ASSERT_EQ(range(1, 5).cmp(range(1, 4)), Ordering::Greater);
+    ASSERT_EQ(range(1, 4).cmp(range(2, 3)), Ordering::Less);
+
+    std::vector<std::string> left{"a", "b", "c"};
+    std::vector<std::string> right{"a", "c"};
+    ASSERT_EQ(container(left).cmp(container(right)), Ordering::Less);
+    ASSERT_TRUE(container(left).lt(container(right)));
+    ASSERT_TRUE(container(left).le(container(right)));
+    ASSERT_FALSE(container(left).gt(container(right)));
+    ASSERT_FALSE(container(left).ge(container(right)));
+    ASSERT_FALSE(container(left).eq(container(right)));
+    ASSERT_TRUE(container(left).ne(container(right)));
+    ASSERT_TRUE(container(left).eq(container(left)));
+
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> floats{1.0, nan};
+    ASSERT_EQ(container(floats).partial_cmp(container(floats)), Option<Ordering>{});
+    ASSERT_FALSE(container(floats).le(container(floats)));
+    ASSERT_EQ(range(1, 3).partial_cmp(range(1, 4)), Option<Ordering>{Ordering::Less});
+}
+
+template <class T>
+void bytewise() {
+    for (size_t size : {0, 1, 7, 8, 9, 255, 256, 257, 1000}) {
+        std::vector<T> left(size);
+        for (size_t i = 0; i < size; ++i) {
+            left[i] = static_cast<T>(i * 37);
+        }
+        auto right = left;
+        static_assert(detail::IsBytewiseV<decltype(container(left)), decltype(container(right))>);
+        ASSERT_TRUE(container(left).eq(container(right)));
+        ASSERT_EQ(container(left).cmp(container(right)), Ordering::Equal);
+
+        for (size_t i = 0; i < size; ++i) {
+            right[i] = static_cast<T>(left[i] + 1);
+            auto expected = vce::compare(left[i], right[i]);
+            ASSERT_EQ(container(left).cmp(container(right)), expected);
+            ASSERT_EQ(container(right).cmp(container(left)), vce::compare(right[i], left[i]));
+            ASSERT_FALSE(container(left).eq(container(right)));
+            ASSERT_EQ(container(left).partial_cmp(container(right)), Option<Ordering>{expected});
+
+            auto iter = container(left);
+            iter.cmp(container(right));
+            ASSERT_EQ(iter.size(), size - i - 1);
+            right[i] = left[i];
+        }
+
+        right.push_back(0);
+        ASSERT_EQ(container(left).cmp(container(right)), Ordering::Less);
+        ASSERT_EQ(container(right).cmp(container(left)), Ordering::Greater);
+        ASSERT_FALSE(container(left).eq(container(right)));
+    }
+}
+
+TEST(CmpBytewise) {
+    bytewise<uint8_t>();
+    bytewise<int8_t>();
+    bytewise<int32_t>();
+    bytewise<uint64_t>();
+
+    std::string left = "abc";
+    std::string right = "ab\xff";
+    ASSERT_EQ(container(left).cmp(container(right)), vce::compare('c', '\xff'));
+}
+
+template <class T>
+void position_eq() {
+    for (size_t size : {0, 1, 7, 31, 32, 33, 64, 65, 1000}) {
+        std::vector<T> values(size, static_cast<T>(3));
+        ASSERT_EQ(container(values).position_eq(4), Option<size_t>{});
+        ASSERT_FALSE(container(values).contains(4));
+
+        for (size_t i = 0; i < size; ++i) {
+            values[i] = static_cast<T>(4);
+            ASSERT_EQ(container(values).position_eq(4), Option<size_t>{i});
+            ASSERT_TRUE(&container(values).find_eq(4).unwrap().get() == &values[i]);
+            ASSERT_TRUE(container(values).contains(static_cast<T>(4)));
+
+            auto iter = container(values);
+            iter.position_eq(4);
+            ASSERT_EQ(iter.size(), size - i - 1);
+
+            if (i + 1 < size) {
+                values[i + 1] = static_cast<T>(5);
+                std::vector<T> needle{static_cast<T>(4), static_cast<T>(5)};
+                ASSERT_EQ(container(values).position_subsequence(needle), Option<size_t>{i});
+                values[i + 1] = static_cast<T>(3);
+            }
+            values[i] = static_cast<T>(3);
+        }
+    }
+}
+
+TEST(PositionEq) {
+    position_eq<char>();
+    position_eq<int8_t>();
+    position_eq<uint16_t>();
+    position_eq<int32_t>();
+    position_eq<uint64_t>();
+
+    std::vector<uint8_t> bytes{0, 44, 255};
+    ASSERT_EQ(container(bytes).position_eq(255), Option<size_t>{2});
+    ASSERT_EQ(container(bytes).position_eq(300), Option<size_t>{});
+    ASSERT_EQ(container(bytes).position_eq(-1), Option<size_t>{});
+
+    std::vector<int8_t> signed_bytes{0, -1};
+    ASSERT_EQ(container(signed_bytes).position_eq(-1), Option<size_t>{1});
+    ASSERT_EQ(container(signed_bytes).position_eq(255), Option<size_t>{});
+
+    ASSERT_EQ(range(1, 9).position_eq(4), Option<size_t>{3});
+    ASSERT_EQ(range(1, 9).find_eq(4), Option<int>{4});
+    ASSERT_FALSE(range(1, 9).contains(9));
+
+    std::vector<std::string> strings{"a", "b", "c"};
+    ASSERT_EQ(container(strings).position_eq("b"), Option<size_t>{1});
+}
+
+TEST(PositionSubsequence) {
+    std::string text = "the quick brown fox jumps over the lazy dog";
+    ASSERT_EQ(container(text).position_subsequence(std::string{"the"}), Option<size_t>{0});
+    ASSERT_EQ(container(text).position_subsequence(std::string{"lazy"}), Option<size_t>{35});
+    ASSERT_EQ(container(text).position_subsequence(std::string{"cat"}), Option<size_t>{});
+    ASSERT_EQ(container(text).position_subsequence(std::string{}), Option<size_t>{0});
+    ASSERT_EQ(container(text).position_subsequence(text + "!"), Option<size_t>{});
+
+    std::vector<int32_t> integers{1, 2, 1, 2, 3, 1};
+    std::vector<int32_t> needle{1, 2, 3};
+    ASSERT_EQ(container(integers).position_subsequence(needle), Option<size_t>{2});
+    needle = {3, 1, 2};
+    ASSERT_EQ(container(integers).position_subsequence(needle), Option<size_t>{});
+
+    ASSERT_EQ(range(0, 10).position_subsequence(std::vector<int>{4, 5}), Option<size_t>{4});
+    ASSERT_EQ(range(0, 10).position_subsequence(std::vector<int>{5, 4}), Option<size_t>{});
+}
+
 TEST(Min) {
     ASSERT_EQ(range(1, 1).min(), Option<int>{});
     ASSERT_EQ(range(1, 4).min(), Option<int>{1});
@@ -21,6 +21,84 @@ ACCEL_TESTS
 using namespace vce;
 
 #include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+template <class T>
+std::vector<T> random(size_t size, T min, T max) {
+    std::mt19937_64 random{322};
+    std::uniform_int_distribution<int64_t> distribution(min, max);
+    std::vector<T> values(size);
+    for (auto& value : values) {
+        value = static_cast<T>(distribution(random));
+    }
+    return values;
+}
+
+template <class T>
+Option<size_t> naive(const std::vector<T>& left, const std::vector<T>& right, bool add) {
+    for (size_t i = 0; i < left.size(); ++i) {
+        auto result = add ? checked_add(left[i], right[i]) : checked_sub(left[i], right[i]);
+        if (result.is_none()) {
+            return {i};
+        }
+    }
+    return {};
+}
+
+template <class T>
+void span_kernels() {
+    auto min = static_cast<int64_t>(std::is_signed_v<T> ? Limits<T>::min() / 2 : 0);
+    auto max = static_cast<int64_t>(Limits<T>::max() / 2);
+
+    for (size_t size : {0, 1, 7, 64, 1000}) {
+        auto left = random<T>(size, min, max);
+        auto right = random<T>(size, min, max);
+        std::vector<T> out(size);
+
+        ASSERT_EQ(checked_add<T>(left, right, out), Option<size_t>{});
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(out[i], static_cast<T>(left[i] + right[i]));
+        }
+
+        ASSERT_EQ(checked_sub<T>(left, right, out), naive(left, right, false));
+
+        if (size > 1) {
+            left[size / 2] = Limits<T>::max();
+            left[size - 1] = Limits<T>::max();
+            right[size / 2] = Limits<T>::max();
+            right[size - 1] = Limits<T>::max();
+            ASSERT_EQ(checked_add<T>(left, right, out), Option<size_t>{size / 2});
+            ASSERT_EQ(naive(left, right, true), Option<size_t>{size / 2});
+        }
+    }
+}
+
+template <class T>
+void sum_kernel() {
+    auto min = static_cast<int64_t>(std::is_signed_v<T> ? Limits<T>::min() : 0);
+    auto max = static_cast<int64_t>(std::min<uint64_t>(Limits<T>::max(), Limits<int64_t>::max()));
+
+    auto values = random<T>(1000, min / 1000, max / 1000);
+    Int128 sum = 0;
+    for (auto value : values) {
+        sum += value;
+    }
+    ASSERT_TRUE(sum == checked_sum<T>(values).unwrap());
+
+    values.push_back(Limits<T>::max());
+    values.push_back(Limits<T>::max());
+    ASSERT_EQ(checked_sum<T>(values), Option<T>{});
+
+    if constexpr (std::is_signed_v<T>) {
+        std::vector<T> reentering(100, Limits<T>::max());
+        reentering.resize(200, Limits<T>::min());
+        ASSERT_EQ(checked_sum<T>(reentering), Option<T>{static_cast<T>(-100)});
+    }
+
+    ASSERT_EQ(checked_sum<T>(Span<const T>{}), Option<T>{0});
+}
 
 TEST(Add) {
     ASSERT_EQ(checked_add<int8_t>(48, 48), (Option<int8_t>{96}));
@@ -75,7 +153,200 @@ TEST(Mul) {
     ASSERT_EQ(saturating_mul<uint8_t>(16, 16), 255);
 }
 
+TEST(SpanKernels) {
+    span_kernels<int8_t>();
+    span_kernels<uint8_t>();
+    span_kernels<int16_t>();
+    span_kernels<uint16_t>();
+    span_kernels<int32_t>();
+    span_kernels<uint32_t>();
+    span_kernels<int64_t>();
+    span_kernels<uint64_t>();
+}
+
+TEST(Sum) {
+    sum_kernel<int8_t>();
+    sum_kernel<uint8_t>();
+    sum_kernel<int16_t>();
+    sum_kernel<uint16_t>();
+    sum_kernel<int32_t>();
+    sum_kernel<uint32_t>();
+    sum_kernel<int64_t>();
+    sum_kernel<uint64_t>();
+}
+
+template <class T>
+T clamp(int64_t value) {
+    return static_cast<T>(std::clamp<int64_t>(value, Limits<T>::min(), Limits<T>::max()));
+}
+
+template <class T>
+void saturating_scalar() {
+    for (int64_t l = Limits<T>::min(); l <= Limits<T>::max(); ++l) {
+        for (int64_t r = Limits<T>::min(); r <= Limits<T>::max(); ++r) {
+            auto left = static_cast<T>(l);
+            auto right = static_cast<T>(r);
+            ASSERT_EQ(saturating_add(left, right), clamp<T>(l + r));
+            ASSERT_EQ(saturating_sub(left, right), clamp<T>(l - r));
+            ASSERT_EQ(saturating_mul(left, right), clamp<T>(l * r));
+        }
+    }
+}
+
+template <class T>
+void saturating_kernels() {
+    auto min = static_cast<int64_t>(std::is_signed_v<T> ? Limits<T>::min() : 0);
+    auto max = static_cast<int64_t>(std::min<uint64_t>(Limits<T>::max(), Limits<int64_t>::max()));
+
+    for (size_t size : {0, 1, 7, 64, 1000}) {
+        auto left = random<T>(size, min, max);
+        auto right = random<T>(size, min, max);
+        for (size_t i = 0; i < size; i += 3) {
+            left[i] = i % 2 == 0 ? Limits<T>::max() : Limits<T>::min();
+        }
+        std::vector<T> out(size);
+
+        saturating_add<T>(left, right, out);
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(out[i], saturating_add(left[i], right[i]));
+        }
+
+        saturating_sub<T>(left, right, out);
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(out[i], saturating_sub(left[i], right[i]));
+        }
+
+        saturating_mul<T>(left, right, out);
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(out[i], saturating_mul(left[i], right[i]));
+        }
+    }
+}
+
+TEST(Saturating) {
+    saturating_scalar<int8_t>();
+    saturating_scalar<uint8_t>();
+
+    ASSERT_EQ(saturating_add<int64_t>(Limits<int64_t>::max(), 1), Limits<int64_t>::max());
+    ASSERT_EQ(saturating_add<int64_t>(Limits<int64_t>::min(), -1), Limits<int64_t>::min());
+    ASSERT_EQ(saturating_sub<uint64_t>(0, 1), 0);
+    ASSERT_EQ(saturating_mul<int64_t>(Limits<int64_t>::min(), -1), Limits<int64_t>::max());
+
+    saturating_kernels<int8_t>();
+    saturating_kernels<uint8_t>();
+    saturating_kernels<int16_t>();
+    saturating_kernels<uint16_t>();
+    saturating_kernels<int32_t>();
+    saturating_kernels<uint32_t>();
+    saturating_kernels<int64_t>();
+    saturating_kernels<uint64_t>();
+}
+
 TEST(Div) {
     ASSERT_EQ(checked_div<int8_t>(64, 8), (Option<int8_t>{8}));
     ASSERT_EQ(checked_div<int8_t>(64, 0), (Option<int8_t>{}));
+    ASSERT_EQ(checked_div<int8_t>(-128, -1), (Option<int8_t>{}));
+    ASSERT_EQ(checked_div<uint8_t>(255, 1), (Option<uint8_t>{255}));
+}
+
+TEST(Rem) {
+    ASSERT_EQ(checked_rem<int8_t>(-7, 3), (Option<int8_t>{-1}));
+    ASSERT_EQ(checked_rem<int8_t>(7, 0), (Option<int8_t>{}));
+    ASSERT_EQ(checked_rem<int8_t>(-128, -1), (Option<int8_t>{}));
+    ASSERT_EQ(checked_rem<uint8_t>(255, 16), (Option<uint8_t>{15}));
+}
+
+TEST(Neg) {
+    ASSERT_EQ(checked_neg<int8_t>(127), (Option<int8_t>{-127}));
+    ASSERT_EQ(checked_neg<int8_t>(-128), (Option<int8_t>{}));
+    ASSERT_EQ(checked_neg<uint8_t>(0), (Option<uint8_t>{0}));
+    ASSERT_EQ(checked_neg<uint8_t>(1), (Option<uint8_t>{}));
+
+    static_assert(wrapping_neg<int8_t>(-128) == -128);
+    static_assert(overflowing_neg<uint8_t>(1) == std::make_pair<uint8_t, bool>(255, true));
+}
+
+TEST(Shift) {
+    ASSERT_EQ(checked_shl<int8_t>(-1, 7), (Option<int8_t>{-128}));
+    ASSERT_EQ(checked_shl<int8_t>(1, 8), (Option<int8_t>{}));
+    ASSERT_EQ(checked_shr<int8_t>(-128, 7), (Option<int8_t>{-1}));
+    ASSERT_EQ(checked_shr<uint64_t>(1, 64), (Option<uint64_t>{}));
+
+    static_assert(wrapping_shl<uint8_t>(1, 9) == 2);
+    static_assert(wrapping_shl<int32_t>(-1, 31) == Limits<int32_t>::min());
+    static_assert(wrapping_shr<int16_t>(-32768, 31) == -1);
+}
+
+TEST(Pow) {
+    ASSERT_EQ(checked_pow<int8_t>(2, 6), (Option<int8_t>{64}));
+    ASSERT_EQ(checked_pow<int8_t>(2, 7), (Option<int8_t>{}));
+    ASSERT_EQ(checked_pow<int8_t>(-2, 7), (Option<int8_t>{-128}));
+    ASSERT_EQ(checked_pow<int8_t>(0, 0), (Option<int8_t>{1}));
+    ASSERT_EQ(checked_pow<uint8_t>(1, 1000), (Option<uint8_t>{1}));
+    ASSERT_EQ(checked_pow<uint64_t>(3, 40), (Option<uint64_t>{12157665459056928801u}));
+    ASSERT_EQ(checked_pow<uint64_t>(3, 41), (Option<uint64_t>{}));
+
+    for (int base = -128; base <= 127; ++base) {
+        int64_t exact = 1;
+        for (uint32_t exponent = 0; exponent < 10; ++exponent) {
+            auto fits = exact >= -128 && exact <= 127;
+            auto expected = fits ? Option<int8_t>{static_cast<int8_t>(exact)} : Option<int8_t>{};
+            ASSERT_EQ(checked_pow(static_cast<int8_t>(base), exponent), expected);
+            exact = std::max<int64_t>(std::min<int64_t>(exact * base, 1 << 20), -(1 << 20));
+        }
+    }
+}
+
+template <class T>
+void overflowing_scalar() {
+    for (int64_t left = Limits<T>::min(); left <= Limits<T>::max(); ++left) {
+        for (int64_t right = Limits<T>::min(); right <= Limits<T>::max(); ++right) {
+            auto l = static_cast<T>(left);
+            auto r = static_cast<T>(right);
+
+            auto sum = left + right;
+            ASSERT_EQ(overflowing_add(l, r).second, sum != static_cast<T>(sum));
+            ASSERT_EQ(wrapping_add(l, r), static_cast<T>(sum));
+            auto difference = left - right;
+            ASSERT_EQ(overflowing_sub(l, r).second, difference != static_cast<T>(difference));
+            ASSERT_EQ(wrapping_sub(l, r), static_cast<T>(difference));
+            auto product = left * right;
+            ASSERT_EQ(overflowing_mul(l, r).second, product != static_cast<T>(product));
+            ASSERT_EQ(wrapping_mul(l, r), static_cast<T>(product));
+
+            ASSERT_EQ(widening_mul(l, r), product);
+            ASSERT_EQ(abs_diff(l, r), static_cast<uint64_t>(std::abs(left - right)));
+        }
+    }
+}
+
+TEST(Wrapping) {
+    overflowing_scalar<int8_t>();
+    overflowing_scalar<uint8_t>();
+
+    static_assert(wrapping_add<int8_t>(127, 1) == -128);
+    static_assert(wrapping_sub<uint32_t>(0, 1) == Limits<uint32_t>::max());
+    static_assert(wrapping_mul<uint16_t>(65535, 65535) == 1);
+    static_assert(overflowing_add<int64_t>(Limits<int64_t>::max(), 1).second);
+    static_assert(!overflowing_mul<int64_t>(Limits<int32_t>::max(), 2).second);
+}
+
+TEST(Widening) {
+    static_assert(std::is_same_v<decltype(widening_mul<uint8_t>(0, 0)), uint16_t>);
+    static_assert(std::is_same_v<decltype(widening_mul<int64_t>(0, 0)), Int128>);
+    static_assert(widening_mul<uint16_t>(65535, 65535) == 4294836225u);
+
+    auto max = widening_mul<uint64_t>(Limits<uint64_t>::max(), Limits<uint64_t>::max());
+    ASSERT_TRUE(static_cast<uint64_t>(max >> 64) == Limits<uint64_t>::max() - 1);
+    ASSERT_TRUE(static_cast<uint64_t>(max) == 1);
+
+    auto min = widening_mul<int64_t>(Limits<int64_t>::min(), Limits<int64_t>::min());
+    ASSERT_TRUE(min == static_cast<Int128>(1) << 126);
+}
+
+TEST(AbsDiff) {
+    static_assert(abs_diff<int8_t>(-128, 127) == 255);
+    static_assert(abs_diff<int64_t>(Limits<int64_t>::max(), Limits<int64_t>::min()) ==
+                  Limits<uint64_t>::max());
+    static_assert(abs_diff<uint32_t>(3, 10) == 7);
 }
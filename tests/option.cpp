@@ -193,6 +193,20 @@ TEST(MoveAssignment) {
     ASSERT_EQ(*p.unwrap(), 322);
 }
 
+TEST(Nested) {
+    Option<Option<int>> a{Option<int>{}};
+    ASSERT_TRUE(a.is_some());
+    ASSERT_TRUE(a.unwrap().is_none());
+
+    Option<Option<int>> b;
+    b = Option<int>{322};
+    ASSERT_EQ(b.unwrap().unwrap(), 322);
+
+    auto c = Option<int>{322}.map([](auto) { return Option<int>{}; });
+    ASSERT_TRUE(c.is_some());
+    ASSERT_TRUE(c.unwrap().is_none());
+}
+
 TEST(AsRef) {
     Option<UP> a;
     ASSERT_THROW(a.as_ref().unwrap());
@@ -201,6 +215,10 @@ TEST(AsRef) {
     Option<UP> b{make(322)};
     ASSERT_EQ(*b.as_ref().unwrap().get(), 322);
     ASSERT_EQ(*b.unwrap(), 322);
+
+    int value = 322;
+    const Option<Ref<int>> c{std::ref(value)};
+    ASSERT_EQ(&c.as_ref().unwrap().get().get(), &value);
 }
 
 TEST(Unwrap) {
@@ -247,6 +265,19 @@ TEST(Convert) {
     ASSERT_EQ(*b.ok_or_else([] { return make(17); }).unwrap_err(), 17);
 }
 
+Option<UP> add(Option<UP> left, Option<UP> right) {
+    auto l = VCE_TRY(std::move(left));
+    auto r = VCE_TRY(std::move(right));
+    return {make(*l + *r)};
+}
+
+TEST(Try) {
+    ASSERT_EQ(*add({make(4)}, {make(17)}).unwrap(), 21);
+    ASSERT_THROW(add({}, {make(17)}).unwrap());
+    ASSERT_THROW(add({make(4)}, {}).unwrap());
+    ASSERT_THROW(add({}, {}).unwrap());
+}
+
 TEST(Compare) {
     ASSERT_EQ(Option<int>{}, Option<float>{});
     ASSERT_EQ(Option<int>{17}, Option<float>{17.0f});
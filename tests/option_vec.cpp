@@ -0,0 +1,115 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/option_vec.hpp>
+
+using namespace vce;
+
+#include <string>
+
+using O = Option<std::string>;
+
+template <class T>
+T get(Option<Ref<const T>> option) {
+    return option.unwrap().get();
+}
+
+TEST(Construction) {
+    OptionVec<std::string> a;
+    ASSERT_EQ(a.size(), 0);
+    ASSERT_TRUE(a.empty());
+
+    OptionVec<std::string> b{O{"4"}, O{}, O{"322"}};
+    ASSERT_EQ(b.size(), 3);
+    ASSERT_EQ(b.count_some(), 2);
+    ASSERT_TRUE(b.is_some(0));
+    ASSERT_FALSE(b.is_some(1));
+    ASSERT_TRUE(b.is_some(2));
+    ASSERT_EQ(get(b.get(0)), "4");
+    ASSERT_THROW(b.get(1).unwrap());
+    ASSERT_EQ(get(b.get(2)), "322");
+
+    b.clear();
+    ASSERT_EQ(b, a);
+}
+
+TEST(Get) {
+    OptionVec<int> a;
+    for (int i = 0; i < 1000; ++i) {
+        a.push_back(i % 7 == 0 ? Option<int>{i} : Option<int>{});
+    }
+    ASSERT_EQ(a.size(), 1000);
+    ASSERT_EQ(a.count_some(), 143);
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 7 == 0) {
+            ASSERT_EQ(get(a.get(i)), i);
+        } else {
+            ASSERT_FALSE(a.is_some(i));
+        }
+    }
+
+    for (size_t i : {1000, 1023, 1024, 100000}) {
+        ASSERT_FALSE(a.is_some(i));
+        ASSERT_TRUE(a.get(i).is_none());
+    }
+    ASSERT_TRUE(OptionVec<int>{}.get(0).is_none());
+}
+
+TEST(Iter) {
+    OptionVec<std::string> a{O{"4"}, O{}, O{"322"}, O{}};
+
+    auto iter1 = a.iter();
+    ASSERT_EQ(iter1.size(), 4);
+    ASSERT_EQ(get(iter1.next().unwrap()), "4");
+    ASSERT_TRUE(iter1.next().unwrap().is_none());
+    ASSERT_TRUE(iter1.next_back().unwrap().is_none());
+    ASSERT_EQ(get(iter1.next_back().unwrap()), "322");
+    ASSERT_TRUE(iter1.next().is_none());
+
+    auto b = a.iter().map([](auto o) { return o.map([](auto s) { return s.get() + "!"; }); });
+    using V = OptionVec<std::string>;
+    ASSERT_EQ(b.collect<V>(), (V{O{"4!"}, O{}, O{"322!"}, O{}}));
+}
+
+TEST(Somes) {
+    OptionVec<int> a;
+    for (int i = 0; i < 1000; ++i) {
+        a.push_back(i % 97 == 3 ? Option<int>{i} : Option<int>{});
+    }
+
+    auto iter1 = a.somes();
+    ASSERT_EQ(iter1.size(), 11);
+    for (int i = 3; i < 1000; i += 97) {
+        auto [index, value] = iter1.next().unwrap();
+        ASSERT_EQ(index, i);
+        ASSERT_EQ(value.get(), i);
+    }
+    ASSERT_TRUE(iter1.next().is_none());
+
+    auto iter2 = a.somes();
+    ASSERT_EQ(iter2.next_back().unwrap().first, 973);
+    ASSERT_EQ(iter2.next().unwrap().first, 3);
+    ASSERT_EQ(iter2.next_back().unwrap().first, 876);
+    ASSERT_EQ(iter2.size(), 8);
+    ASSERT_EQ(iter2.count(), 8);
+
+    OptionVec<int> b{Option<int>{}, Option<int>{}};
+    ASSERT_TRUE(b.somes().next().is_none());
+    ASSERT_TRUE(OptionVec<int>{}.somes().next_back().is_none());
+}
@@ -0,0 +1,102 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/parse.hpp>
+#include <vivace/string.hpp>
+
+using namespace vce;
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using Kind = ParseError::Kind;
+
+template <class T>
+static ParseError error(std::string_view string) {
+    return parse<T>(string).unwrap_err();
+}
+
+TEST(ParseIntegers) {
+    ASSERT_EQ(parse<int>("0").unwrap(), 0);
+    ASSERT_EQ(parse<int>("-17").unwrap(), -17);
+    ASSERT_EQ(parse<int>("+17").unwrap(), 17);
+    ASSERT_EQ(parse<uint8_t>("255").unwrap(), 255);
+    ASSERT_EQ(parse<int16_t>("-32768").unwrap(), -32768);
+
+    // Eight and sixteen digits are parsed without a loop.
+    ASSERT_EQ(parse<int>("12345678").unwrap(), 12345678);
+    ASSERT_EQ(parse<int>("-00000042").unwrap(), -42);
+    ASSERT_EQ(parse<uint32_t>("+99999999").unwrap(), 99999999);
+    ASSERT_EQ(parse<int64_t>("1234567890123456").unwrap(), 1234567890123456);
+    ASSERT_EQ(parse<int64_t>("-9999999999999999").unwrap(), -9999999999999999);
+    ASSERT_EQ(parse<uint64_t>("0000000000000001").unwrap(), 1);
+    ASSERT_EQ(error<int>("1234567890123456"), (ParseError{Kind::OutOfRange, 0}));
+    ASSERT_EQ(error<int>("1234x678"), (ParseError{Kind::Invalid, 4}));
+    ASSERT_EQ(error<int>("-1234567/"), (ParseError{Kind::Invalid, 8}));
+    ASSERT_EQ(error<int64_t>("123456789012345:"), (ParseError{Kind::Invalid, 15}));
+
+    ASSERT_EQ(parse<int64_t>("-9223372036854775808").unwrap(), INT64_MIN);
+    ASSERT_EQ(parse<uint64_t>("18446744073709551615").unwrap(), UINT64_MAX);
+    ASSERT_EQ(error<uint64_t>("18446744073709551616"), (ParseError{Kind::OutOfRange, 0}));
+    ASSERT_EQ(error<int8_t>("128"), (ParseError{Kind::OutOfRange, 0}));
+
+    ASSERT_EQ(error<int>(""), (ParseError{Kind::Empty, 0}));
+    ASSERT_EQ(error<int>("+"), (ParseError{Kind::Invalid, 0}));
+    ASSERT_EQ(error<int>("-"), (ParseError{Kind::Invalid, 0}));
+    ASSERT_EQ(error<int>("+-1"), (ParseError{Kind::Invalid, 0}));
+    ASSERT_EQ(error<int>("+1x"), (ParseError{Kind::Invalid, 2}));
+    ASSERT_EQ(error<int>(" 1"), (ParseError{Kind::Invalid, 0}));
+    ASSERT_EQ(error<int>("1 "), (ParseError{Kind::Invalid, 1}));
+    ASSERT_EQ(error<unsigned>("-1"), (ParseError{Kind::Invalid, 0}));
+    ASSERT_EQ(error<unsigned>("-1234567"), (ParseError{Kind::Invalid, 0}));
+}
+
+TEST(ParseFloats) {
+    ASSERT_EQ(parse<double>("0.5").unwrap(), 0.5);
+    ASSERT_EQ(parse<double>("-1e3").unwrap(), -1000.0);
+    ASSERT_EQ(parse<double>("+.25").unwrap(), 0.25);
+    ASSERT_EQ(parse<float>("3.25").unwrap(), 3.25f);
+    ASSERT_EQ(parse<double>("12345678").unwrap(), 12345678.0);
+    ASSERT_TRUE(std::isinf(parse<double>("inf").unwrap()));
+    ASSERT_TRUE(std::isnan(parse<double>("nan").unwrap()));
+
+    ASSERT_EQ(error<double>("1e999"), (ParseError{Kind::OutOfRange, 0}));
+    ASSERT_EQ(error<double>("1.5.2"), (ParseError{Kind::Invalid, 3}));
+    ASSERT_EQ(error<double>("x"), (ParseError{Kind::Invalid, 0}));
+    ASSERT_EQ(error<double>(""), (ParseError{Kind::Empty, 0}));
+}
+
+TEST(ParseAll) {
+    using Numbers = Result<std::vector<int>, ParseError>;
+    ASSERT_EQ(split("1,-2,30", ',').parse_all<int>().collect<Numbers>().unwrap(),
+        (std::vector<int>{1, -2, 30}));
+
+    auto numbers = split("1,x,3", ',').parse_all<int>();
+    ASSERT_EQ(numbers.next().unwrap().unwrap(), 1);
+    ASSERT_EQ(numbers.next().unwrap().unwrap_err(), (ParseError{Kind::Invalid, 0}));
+    ASSERT_TRUE(numbers.next().is_none());
+    ASSERT_EQ(numbers.bounds(), (Bounds{0, 0}));
+
+    std::vector<std::string> strings{"0.5", "1e2"};
+    ASSERT_EQ(container(strings).parse_all<double>().map([](auto r) { return r.unwrap(); }).sum(),
+        100.5);
+    ASSERT_EQ(split_whitespace("").parse_all<int>().collect<Numbers>().unwrap().size(), 0);
+}
@@ -205,6 +205,19 @@ TEST(Convert) {
     ASSERT_THROW(b.ok().unwrap());
 }
 
+Result<UP, UP> add(Result<UP, UP> left, Result<UP, UP> right) {
+    auto l = VCE_TRY(std::move(left));
+    auto r = VCE_TRY(std::move(right));
+    return {OK, make(*l + *r)};
+}
+
+TEST(Try) {
+    ASSERT_EQ(*add({OK, make(4)}, {OK, make(17)}).unwrap(), 21);
+    ASSERT_EQ(*add({ERR, make(4)}, {OK, make(17)}).unwrap_err(), 4);
+    ASSERT_EQ(*add({OK, make(4)}, {ERR, make(17)}).unwrap_err(), 17);
+    ASSERT_EQ(*add({ERR, make(4)}, {ERR, make(17)}).unwrap_err(), 4);
+}
+
 TEST(Compare) {
     using L = Result<int, long>;
     using R = Result<float, double>;
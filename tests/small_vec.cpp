@@ -0,0 +1,138 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/iterator.hpp>
+#include <vivace/small_vec.hpp>
+
+using namespace vce;
+
+#include <string>
+
+using UP = std::unique_ptr<int>;
+UP make(int value) { return std::make_unique<int>(value); }
+
+TEST(Construction) {
+    SmallVec<int, 4> a;
+    ASSERT_EQ(a.size(), 0);
+    ASSERT_EQ(a.capacity(), 4);
+    ASSERT_TRUE(a.is_inline());
+
+    SmallVec<int, 4> b{4, 17, 322};
+    ASSERT_TRUE(b.is_inline());
+    ASSERT_EQ(b[0], 4);
+    ASSERT_EQ(b[1], 17);
+    ASSERT_EQ(b[2], 322);
+
+    SmallVec<int, 2> c{4, 17, 322};
+    ASSERT_FALSE(c.is_inline());
+    ASSERT_EQ(c, b);
+
+    SmallVec<int, 2> d{c};
+    ASSERT_EQ(d, c);
+
+    SmallVec<int, 2> e{std::move(d)};
+    ASSERT_EQ(e, c);
+    ASSERT_TRUE(d.empty());
+    ASSERT_TRUE(d.is_inline());
+
+    SmallVec<std::string, 4> f{"4", "17", "322"};
+    SmallVec<std::string, 4> g{std::move(f)};
+    ASSERT_TRUE(g.is_inline());
+    ASSERT_EQ(g, (SmallVec<std::string, 4>{"4", "17", "322"}));
+    ASSERT_TRUE(f.empty());
+
+    SmallVec<std::string, 4> h;
+    h = g;
+    ASSERT_EQ(h, g);
+
+    static_assert(std::is_nothrow_move_constructible_v<SmallVec<std::string, 2>>);
+    static_assert(std::is_nothrow_move_assignable_v<SmallVec<std::string, 2>>);
+}
+
+TEST(Spill) {
+    SmallVec<UP, 4> a;
+    for (int i = 0; i < 4; ++i) {
+        a.push_back(make(i));
+    }
+    ASSERT_TRUE(a.is_inline());
+    for (int i = 4; i < 100; ++i) {
+        a.push_back(make(i));
+    }
+    ASSERT_FALSE(a.is_inline());
+    ASSERT_EQ(a.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(*a[i], i);
+    }
+
+    ASSERT_EQ(*a.pop_back().unwrap(), 99);
+    a.clear();
+    ASSERT_THROW(a.pop_back().unwrap());
+}
+
+TEST(Alias) {
+    SmallVec<std::string, 2> a{std::string(64, 'a'), std::string(64, 'b')};
+    a.emplace_back(a[0]);
+    ASSERT_FALSE(a.is_inline());
+    a.emplace_back(a[1]);
+    ASSERT_EQ(a.size(), a.capacity());
+    a.emplace_back(a[a.size() - 1]);
+    ASSERT_EQ(a.size(), 5);
+    ASSERT_EQ(a[2], std::string(64, 'a'));
+    ASSERT_EQ(a[3], std::string(64, 'b'));
+    ASSERT_EQ(a[4], std::string(64, 'b'));
+
+    SmallVec<int, 2> b{4, 17};
+    b.emplace_back(b[0]);
+    b.emplace_back(b[1]);
+    b.emplace_back(b[b.size() - 1]);
+    ASSERT_EQ(b, (SmallVec<int, 2>{4, 17, 4, 17, 17}));
+}
+
+TEST(InsertErase) {
+    SmallVec<std::string, 4> a{"4", "17", "322"};
+    a.insert(1, "9");
+    ASSERT_TRUE(a.is_inline());
+    a.insert(4, "1");
+    ASSERT_FALSE(a.is_inline());
+    ASSERT_EQ(a, (SmallVec<std::string, 4>{"4", "9", "17", "322", "1"}));
+    a.erase(0);
+    a.erase(3);
+    ASSERT_EQ(a, (SmallVec<std::string, 4>{"9", "17", "322"}));
+
+    SmallVec<int, 4> b{4, 17, 322};
+    b.insert(0, 1);
+    b.erase(2);
+    ASSERT_EQ(b, (SmallVec<int, 4>{1, 4, 322}));
+}
+
+TEST(Iterator) {
+    auto a = range(1, 4).collect<SmallVec<int, 4>>();
+    ASSERT_TRUE(a.is_inline());
+    ASSERT_EQ(a, (SmallVec<int, 4>{1, 2, 3}));
+
+    auto b = range(1, 7).collect<SmallVec<int, 4>>();
+    ASSERT_FALSE(b.is_inline());
+    ASSERT_EQ(b.capacity(), 6);
+
+    auto c = range(1, 7).filter([](auto i) { return i % 2 == 0; }).collect<SmallVec<int, 4>>();
+    ASSERT_TRUE(c.is_inline());
+    ASSERT_EQ(c, (SmallVec<int, 4>{2, 4, 6}));
+
+    ASSERT_EQ(container(c).map([](auto i) { return i.get(); }).sum(), 12);
+}
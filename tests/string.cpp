@@ -0,0 +1,125 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/string.hpp>
+
+using namespace vce;
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Strings = std::vector<std::string_view>;
+
+TEST(Split) {
+    ASSERT_EQ(split("a,b,,c", ',').collect(), (Strings{"a", "b", "", "c"}));
+    ASSERT_EQ(split(",a,", ',').collect(), (Strings{"", "a", ""}));
+    ASSERT_EQ(split("", ',').collect(), (Strings{""}));
+    ASSERT_EQ(split("abc", ',').collect(), (Strings{"abc"}));
+    ASSERT_EQ(split("a,b,,c", ',').reverse().collect(), (Strings{"c", "", "b", "a"}));
+
+    auto iterator = split("a,b,c,d", ',');
+    ASSERT_EQ(iterator.bounds(), Bounds(1, 8));
+    ASSERT_EQ(iterator.next().unwrap(), "a");
+    ASSERT_EQ(iterator.next_back().unwrap(), "d");
+    ASSERT_EQ(iterator.next().unwrap(), "b");
+    ASSERT_EQ(iterator.next_back().unwrap(), "c");
+    ASSERT_FALSE(iterator.next().is_some());
+    ASSERT_FALSE(iterator.next_back().is_some());
+    ASSERT_EQ(iterator.bounds(), Bounds(0, 0));
+
+    std::string long_string(1000, 'x');
+    long_string[700] = ',';
+    auto parts = split(long_string, ',').map([](auto s) { return s.size(); }).collect();
+    ASSERT_EQ(parts, (std::vector<size_t>{700, 299}));
+}
+
+TEST(SplitStr) {
+    ASSERT_EQ(split_str("a::b::::c", "::").collect(), (Strings{"a", "b", "", "c"}));
+    ASSERT_EQ(split_str("::a::", "::").collect(), (Strings{"", "a", ""}));
+    ASSERT_EQ(split_str("a:b", "::").collect(), (Strings{"a:b"}));
+    ASSERT_EQ(split_str("abc", "").collect(), (Strings{"abc"}));
+    ASSERT_EQ(split_str("a::b::::c", "::").reverse().collect(), (Strings{"c", "", "b", "a"}));
+    ASSERT_EQ(split_str("a-->b-->c", "-->").bounds(), Bounds(1, 4));
+
+    for (auto [string, delimiter] : {std::pair{"aaa", "aa"}, {"aaaaa", "aa"}, {"ababa", "aba"}}) {
+        auto forward = split_str(string, delimiter).collect();
+        auto backward = split_str(string, delimiter).reverse().collect();
+        std::reverse(backward.begin(), backward.end());
+        ASSERT_EQ(forward, backward);
+    }
+    ASSERT_EQ(split_str("aaa", "aa").collect(), (Strings{"", "a"}));
+    auto iterator = split_str("aaaaa", "aa");
+    ASSERT_EQ(iterator.next_back().unwrap(), "a");
+    ASSERT_EQ(iterator.next().unwrap(), "");
+    ASSERT_EQ(iterator.next().unwrap(), "");
+    ASSERT_FALSE(iterator.next().is_some());
+}
+
+TEST(Lines) {
+    ASSERT_EQ(lines("a\nb\r\nc").collect(), (Strings{"a", "b", "c"}));
+    ASSERT_EQ(lines("a\nb\r\n").collect(), (Strings{"a", "b"}));
+    ASSERT_EQ(lines("a\n\nb\n").collect(), (Strings{"a", "", "b"}));
+    ASSERT_EQ(lines("\n").collect(), (Strings{""}));
+    ASSERT_EQ(lines("").collect(), Strings{});
+    ASSERT_EQ(lines("a\rb\r").collect(), (Strings{"a\rb\r"}));
+    ASSERT_EQ(lines("a\r\nb\r\n\r\nc\r\n").reverse().collect(), (Strings{"c", "", "b", "a"}));
+
+    auto iterator = lines("a\r\nb\r\nc");
+    ASSERT_EQ(iterator.next_back().unwrap(), "c");
+    ASSERT_EQ(iterator.next().unwrap(), "a");
+    ASSERT_EQ(iterator.next_back().unwrap(), "b");
+    ASSERT_FALSE(iterator.next().is_some());
+}
+
+TEST(SplitWhitespace) {
+    ASSERT_EQ(split_whitespace("  a b\t\tc\r\n").collect(), (Strings{"a", "b", "c"}));
+    ASSERT_EQ(split_whitespace("abc").collect(), (Strings{"abc"}));
+    ASSERT_EQ(split_whitespace(" \t\n\v\f\r").collect(), Strings{});
+    ASSERT_EQ(split_whitespace("").collect(), Strings{});
+    ASSERT_EQ(split_whitespace(" a  b c ").reverse().collect(), (Strings{"c", "b", "a"}));
+    ASSERT_EQ(split_whitespace("a b c").bounds(), Bounds(0, 3));
+
+    std::string text;
+    std::vector<std::string> words;
+    for (size_t i = 0; i < 100; ++i) {
+        words.push_back(std::string(i % 37 + 1, static_cast<char>('a' + i % 26)));
+        text += words.back();
+        text += std::string(i % 19 + 1, " \t\n"[i % 3]);
+    }
+    auto forward = split_whitespace(text).collect();
+    ASSERT_EQ(forward.size(), words.size());
+    for (size_t i = 0; i < words.size(); ++i) {
+        ASSERT_EQ(forward[i], words[i]);
+    }
+    auto backward = split_whitespace(text).reverse().collect();
+    std::reverse(backward.begin(), backward.end());
+    ASSERT_EQ(backward, forward);
+}
+
+TEST(Compose) {
+    auto text = "GET /a 200\nPOST /b 500\nGET /c 404\nGET /d 200\n";
+    auto paths = lines(text)
+        .filter([](auto line) { return line.substr(0, 3) == "GET"; })
+        .map([](auto line) { return split(line, ' ').nth(1).unwrap(); })
+        .take(2)
+        .collect();
+    ASSERT_EQ(paths, (Strings{"/a", "/c"}));
+    ASSERT_EQ(split_whitespace("1 2 3 4").count(), 4);
+}
@@ -0,0 +1,131 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/iterator.hpp>
+#include <vivace/thread_pool.hpp>
+
+using namespace vce;
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+/// Sums the supplied integers by recursively joining the sums of their halves.
+static int64_t sum(ThreadPool& pool, const int64_t* data, size_t size) {
+    if (size <= 64) {
+        return range<size_t>(0, size).map([&](size_t i) { return data[i]; }).sum();
+    }
+    auto half = size / 2;
+    auto sums = pool.join(
+        [&] { return sum(pool, data, half); },
+        [&] { return sum(pool, data + half, size - half); }).unwrap();
+    return sums.first + sums.second;
+}
+
+TEST(Spawn) {
+    ThreadPool pool{4};
+    ASSERT_EQ(pool.threads(), 4);
+
+    std::vector<TaskHandle<int>> handles;
+    for (int i = 0; i < 100; ++i) {
+        handles.push_back(pool.spawn([i] { return range(0, i).sum(); }));
+    }
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(handles[i].join().unwrap(), i * (i - 1) / 2);
+    }
+    ASSERT_THROW(handles[0].join());
+
+    auto unit = pool.spawn([] { });
+    ASSERT_EQ(unit.join().unwrap(), Unit{});
+    ASSERT_FALSE(unit.is_finished());
+
+    auto failed = pool.spawn([]() -> int { throw std::runtime_error{"failure"}; });
+    ASSERT_EQ(failed.join().unwrap_err().message(), "failure");
+
+    // Tasks spawned by tasks are pushed onto the deques of the workers and stolen.
+    auto nested = pool.spawn([&pool] {
+        std::vector<TaskHandle<int>> handles;
+        for (int i = 0; i < 1000; ++i) {
+            handles.push_back(pool.spawn([i] { return i; }));
+        }
+        int total = 0;
+        for (auto& handle : handles) {
+            total += handle.join().unwrap();
+        }
+        return total;
+    });
+    ASSERT_EQ(nested.join().unwrap(), 499500);
+}
+
+TEST(Detached) {
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool{2};
+        for (int i = 0; i < 1000; ++i) {
+            pool.spawn([&count] { count.fetch_add(1); });
+        }
+    }
+    ASSERT_EQ(count.load(), 1000);
+}
+
+TEST(Scope) {
+    ThreadPool pool{4, ThreadPool::Affinity::Pinned};
+    std::vector<int> squares(1000);
+    auto result = pool.scope([&](Scope& scope) {
+        for (size_t i = 0; i < squares.size(); ++i) {
+            scope.spawn([&squares, i] { squares[i] = static_cast<int>(i * i); });
+        }
+        return 322;
+    });
+    ASSERT_EQ(result.unwrap(), 322);
+    for (size_t i = 0; i < squares.size(); ++i) {
+        ASSERT_EQ(squares[i], static_cast<int>(i * i));
+    }
+
+    std::atomic<int> count{0};
+    auto failed = pool.scope([&](Scope& scope) {
+        for (int i = 0; i < 100; ++i) {
+            scope.spawn([&count, i] {
+                count.fetch_add(1);
+                if (i == 50) {
+                    throw std::runtime_error{"failure"};
+                }
+            });
+        }
+    });
+    ASSERT_EQ(failed.unwrap_err().message(), "failure");
+    ASSERT_EQ(count.load(), 100);
+
+    ASSERT_THROW(ThreadPool{0});
+}
+
+TEST(Join) {
+    ThreadPool pool{4};
+    std::vector<int64_t> values = range<int64_t>(0, 100000).collect();
+    ASSERT_EQ(sum(pool, values.data(), values.size()), 4999950000);
+
+    auto pair = pool.join([] { return 1; }, [] { }).unwrap();
+    ASSERT_EQ(pair.first, 1);
+
+    auto failed = pool.join([] { }, [] { throw std::runtime_error{"second"}; });
+    ASSERT_EQ(failed.unwrap_err().message(), "second");
+
+    ASSERT_TRUE(ThreadPool::global().threads() >= 1);
+    ASSERT_EQ(ThreadPool::global().spawn([] { return 7; }).join().unwrap(), 7);
+}
@@ -0,0 +1,156 @@
+// Copyright 2017 Kyle Mayes
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <accelerando.hpp>
+
+ACCEL_TESTS
+
+#include <vivace/iterator.hpp>
+#include <vivace/vec.hpp>
+
+using namespace vce;
+
+#include <string>
+
+using UP = std::unique_ptr<int>;
+UP make(int value) { return std::make_unique<int>(value); }
+
+struct Tracked {
+    static constexpr bool RELOCATABLE = true;
+
+    static size_t moves;
+
+    int value;
+
+    Tracked(int value) : value{value} { }
+    Tracked(const Tracked& other) : value{other.value} { }
+    Tracked(Tracked&& other) : value{other.value} { moves += 1; }
+
+    Tracked& operator=(const Tracked& other) = default;
+    Tracked& operator=(Tracked&& other) = default;
+
+    bool operator==(const Tracked& other) const { return value == other.value; }
+};
+
+size_t Tracked::moves = 0;
+
+TEST(Construction) {
+    Vec<int> a;
+    ASSERT_EQ(a.size(), 0);
+    ASSERT_EQ(a.capacity(), 0);
+    ASSERT_TRUE(a.empty());
+
+    Vec<int> b{4, 17, 322};
+    ASSERT_EQ(b.size(), 3);
+    ASSERT_EQ(b[0], 4);
+    ASSERT_EQ(b[1], 17);
+    ASSERT_EQ(b[2], 322);
+
+    Vec<int> c{b};
+    ASSERT_EQ(c, b);
+
+    Vec<int> d{std::move(c)};
+    ASSERT_EQ(d, b);
+    ASSERT_TRUE(c.empty());
+
+    Vec<std::string> e{"4", "17", "322"};
+    Vec<std::string> f;
+    f = e;
+    ASSERT_EQ(f, e);
+    f = std::move(e);
+    ASSERT_EQ(f, (Vec<std::string>{"4", "17", "322"}));
+}
+
+TEST(PushBack) {
+    Vec<UP> a;
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(make(i));
+    }
+    ASSERT_EQ(a.size(), 100);
+    ASSERT_GE(a.capacity(), 100);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(*a[i], i);
+    }
+
+    ASSERT_EQ(*a.pop_back().unwrap(), 99);
+    ASSERT_EQ(a.size(), 99);
+
+    Vec<UP> b;
+    ASSERT_THROW(b.pop_back().unwrap());
+}
+
+TEST(Relocate) {
+    Vec<Tracked> a;
+    Tracked::moves = 0;
+    for (int i = 0; i < 100; ++i) {
+        a.emplace_back(i);
+    }
+    a.insert(0, Tracked{-1});
+    a.erase(50);
+    ASSERT_EQ(Tracked::moves, 1);
+    ASSERT_EQ(a.size(), 100);
+    ASSERT_EQ(a[0].value, -1);
+    ASSERT_EQ(a[49].value, 48);
+    ASSERT_EQ(a[50].value, 50);
+    ASSERT_EQ(a[99].value, 99);
+}
+
+TEST(Alias) {
+    Vec<int> a{4, 17, 322, 1};
+    ASSERT_EQ(a.size(), a.capacity());
+    a.emplace_back(a[0]);
+    a.emplace_back(a[a.size() - 1]);
+    ASSERT_EQ(a, (Vec<int>{4, 17, 322, 1, 4, 4}));
+
+    Vec<std::string> b{std::string(64, 'a')};
+    ASSERT_EQ(b.size(), b.capacity());
+    b.emplace_back(b[0]);
+    b.push_back(b[b.size() - 1]);
+    ASSERT_EQ(b.size(), 3);
+    ASSERT_EQ(b[2], std::string(64, 'a'));
+
+    ASSERT_TRUE(std::is_nothrow_move_constructible_v<Vec<std::string>>);
+    ASSERT_TRUE(std::is_nothrow_move_assignable_v<Vec<std::string>>);
+}
+
+TEST(InsertErase) {
+    Vec<std::string> a{"4", "17", "322"};
+    a.insert(1, "9");
+    a.insert(4, "1");
+    ASSERT_EQ(a, (Vec<std::string>{"4", "9", "17", "322", "1"}));
+    a.erase(0);
+    a.erase(3);
+    ASSERT_EQ(a, (Vec<std::string>{"9", "17", "322"}));
+
+    Vec<int> b{4, 17, 322};
+    b.insert(0, 1);
+    b.erase(2);
+    ASSERT_EQ(b, (Vec<int>{1, 4, 322}));
+    b.clear();
+    ASSERT_TRUE(b.empty());
+}
+
+TEST(Iterator) {
+    auto a = range(1, 4).collect<Vec<int>>();
+    ASSERT_EQ(a, (Vec<int>{1, 2, 3}));
+    ASSERT_EQ(a.capacity(), 3);
+
+    auto b = range(1, 7).filter([](auto i) { return i % 2 == 0; }).collect<Vec<int>>();
+    ASSERT_EQ(b, (Vec<int>{2, 4, 6}));
+
+    auto c = container(a).map([](auto i) { return i.get() * 2; }).collect<Vec<int>>();
+    ASSERT_EQ(c, (Vec<int>{2, 4, 6}));
+    ASSERT_EQ(container(std::move(c)).sum(), 12);
+}